@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+/* A list of nodes_number nodes is built in order in an array with a     */
+/* quarter of free slots, then every churn step removes a random node and */
+/* inserts one after another random node. The walk is timed after each   */
+/* stage for both allocation policies.                                   */
+static const size_t default_nodes_number = 1 << 20;
+static const size_t free_slots_share     = 4;
+static const size_t churn_stages[]       = {0, 1, 2, 4, 8};
+static const size_t walk_rounds          = 4;
+/* Links that jump further than this many slots count as far. */
+static const size_t near_distance        = 64;
+
+/*=======================================================================================*/
+
+static bool         bench_policy     (list_alloc_policy_t policy,
+                                      size_t              nodes_number);
+static list_error_t churn            (linked_list_t       *list,
+                                      std::vector<size_t> *live,
+                                      size_t               steps_number,
+                                      uint64_t            *random);
+static size_t       random_below     (size_t               bound,
+                                      uint64_t            *random);
+static double       walk             (linked_list_t       *list,
+                                      long long           *sum);
+static double       far_links_share  (linked_list_t       *list);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    printf("%zu nodes, churn in multiples of the size\n", nodes_number);
+    printf("%-8s | %6s | %12s | %13s | %9s\n", "policy", "churn", "churn ns/op", "walk ns/node", "far links");
+
+    bool passed = bench_policy(LINKED_LIST_ALLOC_LIFO,    nodes_number) &&
+                  bench_policy(LINKED_LIST_ALLOC_NEAREST, nodes_number);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+bool bench_policy(list_alloc_policy_t policy, size_t nodes_number) {
+    const char *name = policy == LINKED_LIST_ALLOC_LIFO ? "lifo" : "nearest";
+
+    linked_list_t list = {};
+    if(linked_list_ctor(&list, nodes_number + nodes_number / free_slots_share) != LINKED_LIST_SUCCESS ||
+       linked_list_set_alloc_policy(&list, policy) != LINKED_LIST_SUCCESS) {
+        return false;
+    }
+    std::vector<size_t> live(nodes_number);
+    for(size_t node = 0; node < nodes_number; node++) {
+        if(linked_list_insert_before(&list, 0, (data_t)node) != LINKED_LIST_SUCCESS) {
+            linked_list_dtor(&list);
+            return false;
+        }
+        live[node] = linked_list_get_tail(&list);
+    }
+
+    /* Same seed for both policies. Churn moves values around, so every */
+    /* walk sums to the same total.                                     */
+    uint64_t  random  = 0x9e3779b97f4a7c15ull;
+    size_t    churned = 0;
+    long long total   = (long long)(nodes_number * (nodes_number - 1) / 2 * walk_rounds);
+    bool      passed  = true;
+    for(size_t stage = 0; stage < sizeof(churn_stages) / sizeof(churn_stages[0]); stage++) {
+        size_t steps_number = churn_stages[stage] * nodes_number - churned;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if(churn(&list, &live, steps_number, &random) != LINKED_LIST_SUCCESS) {
+            linked_list_dtor(&list);
+            return false;
+        }
+        double churn_ns = steps_number == 0 ? 0 : nanoseconds_since(start) / (double)steps_number;
+        churned += steps_number;
+
+        long long sum     = 0;
+        double    walk_ns = walk(&list, &sum);
+        printf("%-8s | %5zux | %12.1f | %13.2f | %9.3f\n",
+               name, churn_stages[stage], churn_ns, walk_ns, far_links_share(&list));
+        passed = passed && sum == total;
+    }
+
+    if(!passed) {
+        printf("%s: walk sums differ\n", name);
+    }
+    linked_list_dtor(&list);
+    return passed;
+}
+
+/*=======================================================================================*/
+
+/* live holds the real indices of all nodes, the inserted node takes the */
+/* place of the removed one.                                             */
+list_error_t churn(linked_list_t *list, std::vector<size_t> *live, size_t steps_number, uint64_t *random) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    for(size_t step = 0; step < steps_number; step++) {
+        size_t removed_at = random_below(live->size(), random);
+        data_t removed    = 0;
+        if((error_code = linked_list_remove(list, (*live)[removed_at], &removed)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+        (*live)[removed_at] = (*live).back();
+
+        size_t after = (*live)[random_below(live->size() - 1, random)];
+        if((error_code = linked_list_insert_after(list, after, removed)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+        (*live).back() = linked_list_next(list, after);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+size_t random_below(size_t bound, uint64_t *random) {
+    *random ^= *random << 13;
+    *random ^= *random >> 7;
+    *random ^= *random << 17;
+    return (size_t)(*random % bound);
+}
+
+/*=======================================================================================*/
+
+double walk(linked_list_t *list, long long *sum) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t round = 0; round < walk_rounds; round++) {
+        for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+            *sum += linked_list_data(list, node);
+        }
+    }
+    return nanoseconds_since(start) / (double)(list->size * walk_rounds);
+}
+
+/*=======================================================================================*/
+
+double far_links_share(linked_list_t *list) {
+    size_t far_links = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        size_t next = linked_list_next(list, node);
+        if(next != 0 && (next > node + near_distance || node > next + near_distance)) {
+            far_links++;
+        }
+    }
+    return (double)far_links / (double)list->size;
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
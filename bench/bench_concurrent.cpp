@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_operations_number = 1 << 22;
+static const size_t max_threads_number        = 64;
+static const size_t max_owned_nodes           = 256;
+
+/*=======================================================================================*/
+
+/* Every thread inserts next to and removes only the nodes it owns, and */
+/* tags them with its number, so a lost or stolen node shows up.         */
+struct worker_t {
+    size_t       thread;
+    size_t       operations_number;
+    size_t       owned[max_owned_nodes];
+    size_t       owned_number;
+    size_t       errors;
+    uint64_t     random;
+};
+
+struct locked_list_t {
+    std::mutex    mutex;
+    linked_list_t list;
+};
+
+/*=======================================================================================*/
+
+static void         run_concurrent   (concurrent_linked_list_t *list,
+                                      worker_t                 *worker);
+static void         run_locked       (locked_list_t            *list,
+                                      worker_t                 *worker);
+static bool         next_is_insert   (worker_t                 *worker,
+                                      size_t                   *slot);
+static double       bench_concurrent (size_t                    threads_number,
+                                      size_t                    operations_number,
+                                      bool                     *passed);
+static double       bench_locked     (size_t                    threads_number,
+                                      size_t                    operations_number);
+static double       seconds_since    (std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t operations_number = default_operations_number;
+    if(argc > 1) {
+        operations_number = strtoull(argv[1], NULL, 10);
+    }
+
+    printf("%-8s | %16s | %16s | %s\n", "threads", "locked Mops/s", "concurrent Mops/s", "stress");
+    bool all_passed = true;
+    for(size_t threads_number = 1; threads_number <= max_threads_number; threads_number *= 2) {
+        bool   passed     = false;
+        double locked     = bench_locked    (threads_number, operations_number);
+        double concurrent = bench_concurrent(threads_number, operations_number, &passed);
+        printf("%-8zu | %16.2f | %16.2f | %s\n",
+               threads_number,
+               (double)operations_number / locked     / 1e6,
+               (double)operations_number / concurrent / 1e6,
+               passed ? "ok" : "FAILED");
+        all_passed = all_passed && passed;
+    }
+    return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Mostly inserts while the thread owns few nodes, mostly removes once it */
+/* owns many, so the list keeps churning at a steady size.                */
+bool next_is_insert(worker_t *worker, size_t *slot) {
+    worker->random ^= worker->random << 13;
+    worker->random ^= worker->random >> 7;
+    worker->random ^= worker->random << 17;
+
+    if(worker->owned_number == 0) {
+        *slot = 0;
+        return true;
+    }
+    *slot = (size_t)(worker->random >> 32) % worker->owned_number;
+    if(worker->owned_number == max_owned_nodes) {
+        return false;
+    }
+    return (worker->random & 0xff) >= worker->owned_number;
+}
+
+/*=======================================================================================*/
+
+void run_concurrent(concurrent_linked_list_t *list, worker_t *worker) {
+    concurrent_list_cache_t cache = {};
+    concurrent_list_attach(list, &cache);
+
+    for(size_t operation = 0; operation < worker->operations_number; operation++) {
+        size_t slot = 0;
+        if(next_is_insert(worker, &slot)) {
+            size_t after    = worker->owned_number == 0 ? 0 : worker->owned[slot];
+            size_t inserted = 0;
+            if(concurrent_list_insert_after(list, &cache, after, (data_t)worker->thread, &inserted) != LINKED_LIST_SUCCESS) {
+                worker->errors++;
+                continue;
+            }
+            worker->owned[worker->owned_number++] = inserted;
+        }
+        else {
+            data_t output = 0;
+            if(concurrent_list_remove(list, &cache, worker->owned[slot], &output) != LINKED_LIST_SUCCESS ||
+               output != (data_t)worker->thread) {
+                worker->errors++;
+            }
+            worker->owned[slot] = worker->owned[--worker->owned_number];
+        }
+    }
+
+    concurrent_list_detach(list, &cache);
+}
+
+/*=======================================================================================*/
+
+/* What a caller does today: one mutex around the ordinary list. */
+void run_locked(locked_list_t *list, worker_t *worker) {
+    for(size_t operation = 0; operation < worker->operations_number; operation++) {
+        size_t slot = 0;
+        if(next_is_insert(worker, &slot)) {
+            size_t after = worker->owned_number == 0 ? 0 : worker->owned[slot];
+            std::lock_guard<std::mutex> lock(list->mutex);
+            linked_list_insert_after(&list->list, after, (data_t)worker->thread);
+            worker->owned[worker->owned_number++] = linked_list_next(&list->list, after);
+        }
+        else {
+            data_t output = 0;
+            std::lock_guard<std::mutex> lock(list->mutex);
+            linked_list_remove(&list->list, worker->owned[slot], &output);
+            worker->owned[slot] = worker->owned[--worker->owned_number];
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+double bench_concurrent(size_t threads_number, size_t operations_number, bool *passed) {
+    concurrent_linked_list_t *list    = new concurrent_linked_list_t();
+    worker_t                 *workers = (worker_t *)calloc(threads_number, sizeof(worker_t));
+    std::thread              *threads = new std::thread[threads_number];
+    concurrent_list_ctor(list, 1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t thread = 0; thread < threads_number; thread++) {
+        workers[thread].thread            = thread;
+        workers[thread].operations_number = operations_number / threads_number;
+        workers[thread].random            = 0x9e3779b97f4a7c15ull * (thread + 1);
+        threads[thread] = std::thread(run_concurrent, list, &workers[thread]);
+    }
+    for(size_t thread = 0; thread < threads_number; thread++) {
+        threads[thread].join();
+    }
+    double seconds = seconds_since(start);
+
+    size_t owned  = 0;
+    size_t errors = 0;
+    for(size_t thread = 0; thread < threads_number; thread++) {
+        owned  += workers[thread].owned_number;
+        errors += workers[thread].errors;
+    }
+    *passed = errors == 0 &&
+              concurrent_list_verify(list) == LINKED_LIST_SUCCESS &&
+              list->size.load() == owned;
+
+    concurrent_list_dtor(list);
+    delete[] threads;
+    free(workers);
+    delete list;
+    return seconds;
+}
+
+/*=======================================================================================*/
+
+double bench_locked(size_t threads_number, size_t operations_number) {
+    locked_list_t *list    = new locked_list_t();
+    worker_t      *workers = (worker_t *)calloc(threads_number, sizeof(worker_t));
+    std::thread   *threads = new std::thread[threads_number];
+    linked_list_ctor(&list->list, 1);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t thread = 0; thread < threads_number; thread++) {
+        workers[thread].thread            = thread;
+        workers[thread].operations_number = operations_number / threads_number;
+        workers[thread].random            = 0x9e3779b97f4a7c15ull * (thread + 1);
+        threads[thread] = std::thread(run_locked, list, &workers[thread]);
+    }
+    for(size_t thread = 0; thread < threads_number; thread++) {
+        threads[thread].join();
+    }
+    double seconds = seconds_since(start);
+
+    linked_list_dtor(&list->list);
+    delete[] threads;
+    free(workers);
+    delete list;
+    return seconds;
+}
+
+/*=======================================================================================*/
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
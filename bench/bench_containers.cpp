@@ -0,0 +1,611 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <vector>
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+/* Every measurement starts from a container of base_size elements and runs */
+/* base_size / 2 operations on it. Operations that are O(n) for a container  */
+/* (vector at the head, both arrays in the middle) run slow_operations.      */
+static const size_t default_base_size = 1 << 18;
+static const size_t slow_operations   = 1 << 11;
+static const size_t traverse_rounds   = 8;
+
+enum bench_operation_t {
+    BENCH_PUSH_HEAD   = 0,
+    BENCH_PUSH_TAIL   = 1,
+    BENCH_PUSH_MIDDLE = 2,
+    BENCH_PUSH_RANDOM = 3,
+    BENCH_POP_HEAD    = 4,
+    BENCH_POP_TAIL    = 5,
+    BENCH_POP_MIDDLE  = 6,
+    BENCH_POP_RANDOM  = 7,
+    BENCH_TRAVERSE    = 8,
+    BENCH_GROWTH      = 9,
+    BENCH_OPERATIONS  = 10,
+};
+
+static const char *operation_names[BENCH_OPERATIONS] = {
+    "push head", "push tail", "push middle", "push random",
+    "pop head",  "pop tail",  "pop middle",  "pop random",
+    "traverse",  "growth",
+};
+
+struct bench_result_t {
+    double ns;
+    double misses;
+};
+
+/* Hardware cache misses of this thread, fd is -1 where perf events are */
+/* not available and only times are printed.                            */
+struct perf_counter_t {
+    int fd;
+};
+
+/*=======================================================================================*/
+
+/* Containers are driven through one adapter each. "Random" and "middle"  */
+/* mean a node the caller holds a handle to for the lists, a real index or */
+/* an iterator, and an index for the arrays, which is what each is used    */
+/* with in practice.                                                       */
+struct index_list_state_t {
+    linked_list_t       list;
+    std::vector<size_t> handles;
+    size_t              middle;
+};
+
+struct std_list_state_t {
+    std::list<int>                           list;
+    std::vector<std::list<int>::iterator>    handles;
+    std::list<int>::iterator                 middle;
+};
+
+template <typename array_t>
+struct array_state_t {
+    array_t array;
+};
+
+/*=======================================================================================*/
+
+static uint64_t random_next  (uint64_t *random);
+static void     perf_open    (perf_counter_t *counter);
+static void     perf_start   (perf_counter_t *counter);
+static uint64_t perf_stop    (perf_counter_t *counter);
+static void     perf_close   (perf_counter_t *counter);
+static double   nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+static void      index_list_init   (index_list_state_t *state, size_t size, size_t capacity);
+static void      index_list_churn  (index_list_state_t *state, uint64_t *random);
+static void      index_list_run    (index_list_state_t *state, bench_operation_t operation,
+                                    size_t operations, uint64_t *random, long long *sink);
+static void      state_destroy     (index_list_state_t *state);
+template <typename state_t>
+static void      state_destroy     (state_t *state);
+
+static void      std_list_init     (std_list_state_t *state, size_t size);
+static void      std_list_churn    (std_list_state_t *state, uint64_t *random);
+static void      std_list_run      (std_list_state_t *state, bench_operation_t operation,
+                                    size_t operations, uint64_t *random, long long *sink);
+
+template <typename array_t>
+static void      array_init        (array_state_t<array_t> *state, size_t size);
+template <typename array_t>
+static void      array_run         (array_state_t<array_t> *state, bench_operation_t operation,
+                                    size_t operations, uint64_t *random, long long *sink);
+template <typename array_t>
+static bool      array_is_slow     (bench_operation_t operation);
+
+template <typename state_t, typename prepare_t, typename run_t>
+static bench_result_t measure      (perf_counter_t *counter, size_t operations,
+                                    prepare_t prepare, run_t run);
+static size_t    operations_number (bench_operation_t operation, size_t base_size, bool slow);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t base_size = default_base_size;
+    if(argc > 1) {
+        base_size = strtoull(argv[1], NULL, 10);
+    }
+
+    perf_counter_t counter = {};
+    perf_open(&counter);
+
+    printf("base size %zu, cache misses %s\n", base_size,
+           counter.fd >= 0 ? "from perf events" : "not available");
+    printf("%-12s %-7s | %22s | %22s | %22s | %22s\n", "operation", "state",
+           "index list ns (miss)", "std::list ns (miss)", "std::vector ns (miss)", "std::deque ns (miss)");
+
+    long long sink = 0;
+    for(size_t churned = 0; churned < 2; churned++) {
+        for(size_t index = 0; index < BENCH_OPERATIONS; index++) {
+            bench_operation_t operation = (bench_operation_t)index;
+            if(churned && operation == BENCH_GROWTH) {
+                continue;
+            }
+
+            /* Growth starts from the smallest capacity, the rest from a full list. */
+            size_t size = operation == BENCH_GROWTH ? 0 : base_size;
+            bench_result_t results[4] = {};
+
+            size_t operations = operations_number(operation, base_size, false);
+            results[0] = measure<index_list_state_t>(&counter, operations,
+                [=](index_list_state_t *state, uint64_t *random) {
+                    index_list_init(state, size, operation == BENCH_GROWTH ? 1 : size);
+                    if(churned) {
+                        index_list_churn(state, random);
+                    }
+                },
+                [&](index_list_state_t *state, uint64_t *random) {
+                    index_list_run(state, operation, operations, random, &sink);
+                });
+            results[1] = measure<std_list_state_t>(&counter, operations,
+                [=](std_list_state_t *state, uint64_t *random) {
+                    std_list_init(state, size);
+                    if(churned) {
+                        std_list_churn(state, random);
+                    }
+                },
+                [&](std_list_state_t *state, uint64_t *random) {
+                    std_list_run(state, operation, operations, random, &sink);
+                });
+
+            /* Arrays have no layout to fragment, churned runs match fresh ones. */
+            size_t vector_operations = operations_number(operation, base_size,
+                                                         array_is_slow<std::vector<int> >(operation));
+            results[2] = measure<array_state_t<std::vector<int> > >(&counter, vector_operations,
+                [=](array_state_t<std::vector<int> > *state, uint64_t *) {
+                    array_init(state, size);
+                },
+                [&](array_state_t<std::vector<int> > *state, uint64_t *random) {
+                    array_run(state, operation, vector_operations, random, &sink);
+                });
+            size_t deque_operations = operations_number(operation, base_size,
+                                                        array_is_slow<std::deque<int> >(operation));
+            results[3] = measure<array_state_t<std::deque<int> > >(&counter, deque_operations,
+                [=](array_state_t<std::deque<int> > *state, uint64_t *) {
+                    array_init(state, size);
+                },
+                [&](array_state_t<std::deque<int> > *state, uint64_t *random) {
+                    array_run(state, operation, deque_operations, random, &sink);
+                });
+
+            printf("%-12s %-7s", operation_names[operation], churned ? "churned" : "fresh");
+            for(size_t container = 0; container < 4; container++) {
+                if(counter.fd >= 0) {
+                    printf(" | %12.2f (%7.3f)", results[container].ns, results[container].misses);
+                }
+                else {
+                    printf(" | %12.2f %9s", results[container].ns, "");
+                }
+            }
+            printf("\n");
+        }
+    }
+
+    perf_close(&counter);
+    /* Keeps the loops from being optimized away. */
+    return sink == 1 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* prepare builds the state untimed, run is timed and counted. */
+template <typename state_t, typename prepare_t, typename run_t>
+bench_result_t measure(perf_counter_t *counter, size_t operations, prepare_t prepare, run_t run) {
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    state_t *state  = new state_t();
+    prepare(state, &random);
+
+    perf_start(counter);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    run(state, &random);
+    double   nanoseconds = nanoseconds_since(start);
+    uint64_t misses      = perf_stop(counter);
+
+    state_destroy(state);
+    delete state;
+
+    bench_result_t result = {};
+    result.ns     = nanoseconds / (double)operations;
+    result.misses = (double)misses / (double)operations;
+    return result;
+}
+
+/*=======================================================================================*/
+
+/* Pops leave at least half of the container, traversal counts elements. */
+size_t operations_number(bench_operation_t operation, size_t base_size, bool slow) {
+    size_t operations = base_size / 2;
+    if(operation == BENCH_TRAVERSE) {
+        operations = base_size * traverse_rounds;
+    }
+    if(operation == BENCH_GROWTH) {
+        operations = base_size;
+    }
+    if(slow && operations > slow_operations) {
+        operations = slow_operations;
+    }
+    return operations == 0 ? 1 : operations;
+}
+
+/*=======================================================================================*/
+
+void index_list_init(index_list_state_t *state, size_t size, size_t capacity) {
+    linked_list_ctor(&state->list, capacity);
+    state->handles.reserve(size + size / 2);
+    for(size_t element = 0; element < size; element++) {
+        linked_list_insert_before(&state->list, 0, (data_t)element);
+        state->handles.push_back(linked_list_prev(&state->list, 0));
+    }
+    state->middle = size < 2 ? 0 : state->handles[size / 2 - 1];
+}
+
+/*=======================================================================================*/
+
+/* Removes and reinserts as many elements as the list holds at random */
+/* places, the held middle node stays but drifts from the middle.     */
+void index_list_churn(index_list_state_t *state, uint64_t *random) {
+    size_t size = state->handles.size();
+    if(size < 2) {
+        return;
+    }
+    for(size_t step = 0; step < size; step++) {
+        size_t  handle = (size_t)(random_next(random) % size);
+        size_t  node   = state->handles[handle];
+        data_t  value  = 0;
+        if(node == state->middle) {
+            continue;
+        }
+        linked_list_remove(&state->list, node, &value);
+        state->handles[handle] = state->handles.back();
+        state->handles.pop_back();
+
+        size_t after = state->handles[(size_t)(random_next(random) % state->handles.size())];
+        linked_list_insert_after(&state->list, after, value);
+        state->handles.push_back(linked_list_next(&state->list, after));
+    }
+}
+
+/*=======================================================================================*/
+
+void index_list_run(index_list_state_t *state, bench_operation_t operation,
+                    size_t operations, uint64_t *random, long long *sink) {
+    linked_list_t *list  = &state->list;
+    data_t         value = 0;
+    for(size_t step = 0; step < operations; step++) {
+        switch(operation) {
+            case BENCH_PUSH_HEAD: {
+                linked_list_insert_after(list, 0, (data_t)step);
+                break;
+            }
+            case BENCH_PUSH_TAIL:
+            case BENCH_GROWTH: {
+                linked_list_insert_before(list, 0, (data_t)step);
+                break;
+            }
+            case BENCH_PUSH_MIDDLE: {
+                linked_list_insert_after(list, state->middle, (data_t)step);
+                break;
+            }
+            case BENCH_PUSH_RANDOM: {
+                size_t after = state->handles[(size_t)(random_next(random) % state->handles.size())];
+                linked_list_insert_after(list, after, (data_t)step);
+                state->handles.push_back(linked_list_next(list, after));
+                break;
+            }
+            case BENCH_POP_HEAD: {
+                linked_list_remove(list, linked_list_next(list, 0), &value);
+                break;
+            }
+            case BENCH_POP_TAIL: {
+                linked_list_remove(list, linked_list_prev(list, 0), &value);
+                break;
+            }
+            case BENCH_POP_MIDDLE: {
+                size_t node = linked_list_next(list, state->middle);
+                linked_list_remove(list, node != 0 ? node : linked_list_prev(list, state->middle), &value);
+                break;
+            }
+            case BENCH_POP_RANDOM: {
+                size_t handle = (size_t)(random_next(random) % state->handles.size());
+                linked_list_remove(list, state->handles[handle], &value);
+                state->handles[handle] = state->handles.back();
+                state->handles.pop_back();
+                break;
+            }
+            case BENCH_TRAVERSE: {
+                for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+                    *sink += linked_list_data(list, node);
+                }
+                step += list->size - 1;
+                break;
+            }
+            case BENCH_OPERATIONS:
+            default: {
+                break;
+            }
+        }
+        *sink += value;
+    }
+}
+
+/*=======================================================================================*/
+
+/* The std containers are freed by delete, the list needs its dtor. */
+void state_destroy(index_list_state_t *state) {
+    linked_list_dtor(&state->list);
+}
+
+template <typename state_t>
+void state_destroy(state_t *) {
+}
+
+/*=======================================================================================*/
+
+void std_list_init(std_list_state_t *state, size_t size) {
+    state->handles.reserve(size + size / 2);
+    for(size_t element = 0; element < size; element++) {
+        state->list.push_back((int)element);
+        state->handles.push_back(std::prev(state->list.end()));
+    }
+    state->middle = size < 2 ? state->list.end() : state->handles[size / 2 - 1];
+}
+
+/*=======================================================================================*/
+
+void std_list_churn(std_list_state_t *state, uint64_t *random) {
+    size_t size = state->handles.size();
+    if(size < 2) {
+        return;
+    }
+    for(size_t step = 0; step < size; step++) {
+        size_t                   handle = (size_t)(random_next(random) % size);
+        std::list<int>::iterator node   = state->handles[handle];
+        if(node == state->middle) {
+            continue;
+        }
+        int value = *node;
+        state->list.erase(node);
+        state->handles[handle] = state->handles.back();
+        state->handles.pop_back();
+
+        std::list<int>::iterator after = state->handles[(size_t)(random_next(random) % state->handles.size())];
+        state->handles.push_back(state->list.insert(std::next(after), value));
+    }
+}
+
+/*=======================================================================================*/
+
+void std_list_run(std_list_state_t *state, bench_operation_t operation,
+                  size_t operations, uint64_t *random, long long *sink) {
+    std::list<int> &list = state->list;
+    for(size_t step = 0; step < operations; step++) {
+        switch(operation) {
+            case BENCH_PUSH_HEAD: {
+                list.push_front((int)step);
+                break;
+            }
+            case BENCH_PUSH_TAIL:
+            case BENCH_GROWTH: {
+                list.push_back((int)step);
+                break;
+            }
+            case BENCH_PUSH_MIDDLE: {
+                list.insert(std::next(state->middle), (int)step);
+                break;
+            }
+            case BENCH_PUSH_RANDOM: {
+                std::list<int>::iterator after = state->handles[(size_t)(random_next(random) % state->handles.size())];
+                state->handles.push_back(list.insert(std::next(after), (int)step));
+                break;
+            }
+            case BENCH_POP_HEAD: {
+                *sink += list.front();
+                list.pop_front();
+                break;
+            }
+            case BENCH_POP_TAIL: {
+                *sink += list.back();
+                list.pop_back();
+                break;
+            }
+            case BENCH_POP_MIDDLE: {
+                std::list<int>::iterator node = std::next(state->middle);
+                if(node == list.end()) {
+                    node = std::prev(state->middle);
+                }
+                *sink += *node;
+                list.erase(node);
+                break;
+            }
+            case BENCH_POP_RANDOM: {
+                size_t handle = (size_t)(random_next(random) % state->handles.size());
+                *sink += *state->handles[handle];
+                list.erase(state->handles[handle]);
+                state->handles[handle] = state->handles.back();
+                state->handles.pop_back();
+                break;
+            }
+            case BENCH_TRAVERSE: {
+                for(int value : list) {
+                    *sink += value;
+                }
+                step += list.size() - 1;
+                break;
+            }
+            case BENCH_OPERATIONS:
+            default: {
+                break;
+            }
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+template <typename array_t>
+void array_init(array_state_t<array_t> *state, size_t size) {
+    for(size_t element = 0; element < size; element++) {
+        state->array.push_back((int)element);
+    }
+}
+
+/*=======================================================================================*/
+
+template <typename array_t>
+void array_run(array_state_t<array_t> *state, bench_operation_t operation,
+               size_t operations, uint64_t *random, long long *sink) {
+    array_t &array = state->array;
+    for(size_t step = 0; step < operations; step++) {
+        switch(operation) {
+            case BENCH_PUSH_HEAD: {
+                array.insert(array.begin(), (int)step);
+                break;
+            }
+            case BENCH_PUSH_TAIL:
+            case BENCH_GROWTH: {
+                array.push_back((int)step);
+                break;
+            }
+            case BENCH_PUSH_MIDDLE: {
+                array.insert(array.begin() + (ptrdiff_t)(array.size() / 2), (int)step);
+                break;
+            }
+            case BENCH_PUSH_RANDOM: {
+                array.insert(array.begin() + (ptrdiff_t)(random_next(random) % (array.size() + 1)), (int)step);
+                break;
+            }
+            case BENCH_POP_HEAD: {
+                *sink += array.front();
+                array.erase(array.begin());
+                break;
+            }
+            case BENCH_POP_TAIL: {
+                *sink += array.back();
+                array.pop_back();
+                break;
+            }
+            case BENCH_POP_MIDDLE: {
+                *sink += array[array.size() / 2];
+                array.erase(array.begin() + (ptrdiff_t)(array.size() / 2));
+                break;
+            }
+            case BENCH_POP_RANDOM: {
+                ptrdiff_t position = (ptrdiff_t)(random_next(random) % array.size());
+                *sink += array[(size_t)position];
+                array.erase(array.begin() + position);
+                break;
+            }
+            case BENCH_TRAVERSE: {
+                for(int value : array) {
+                    *sink += value;
+                }
+                step += array.size() - 1;
+                break;
+            }
+            case BENCH_OPERATIONS:
+            default: {
+                break;
+            }
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+/* The operations that move a share of the array, deque is O(1) at the head. */
+template <typename array_t>
+bool array_is_slow(bench_operation_t operation) {
+    bool head = operation == BENCH_PUSH_HEAD || operation == BENCH_POP_HEAD;
+    return operation == BENCH_PUSH_MIDDLE || operation == BENCH_PUSH_RANDOM ||
+           operation == BENCH_POP_MIDDLE  || operation == BENCH_POP_RANDOM  ||
+           (head && std::is_same<array_t, std::vector<int> >::value);
+}
+
+/*=======================================================================================*/
+
+uint64_t random_next(uint64_t *random) {
+    *random ^= *random << 13;
+    *random ^= *random >> 7;
+    *random ^= *random << 17;
+    return *random;
+}
+
+/*=======================================================================================*/
+
+void perf_open(perf_counter_t *counter) {
+    counter->fd = -1;
+    #ifdef __linux__
+        struct perf_event_attr attributes = {};
+        attributes.type           = PERF_TYPE_HARDWARE;
+        attributes.size           = sizeof(attributes);
+        attributes.config         = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled       = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+        counter->fd = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    #endif
+}
+
+/*=======================================================================================*/
+
+void perf_start(perf_counter_t *counter) {
+    #ifdef __linux__
+        if(counter->fd >= 0) {
+            ioctl(counter->fd, PERF_EVENT_IOC_RESET,  0);
+            ioctl(counter->fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    #else
+        (void)counter;
+    #endif
+}
+
+/*=======================================================================================*/
+
+uint64_t perf_stop(perf_counter_t *counter) {
+    uint64_t misses = 0;
+    #ifdef __linux__
+        if(counter->fd >= 0) {
+            ioctl(counter->fd, PERF_EVENT_IOC_DISABLE, 0);
+            if(read(counter->fd, &misses, sizeof(misses)) != (ssize_t)sizeof(misses)) {
+                misses = 0;
+            }
+        }
+    #else
+        (void)counter;
+    #endif
+    return misses;
+}
+
+/*=======================================================================================*/
+
+void perf_close(perf_counter_t *counter) {
+    #ifdef __linux__
+        if(counter->fd >= 0) {
+            close(counter->fd);
+        }
+    #endif
+    counter->fd = -1;
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_elements_number = 1 << 22;
+static const size_t churn_rounds            = 4;
+
+/*=======================================================================================*/
+
+struct layout_result_t {
+    double fill_ns;
+    double walk_ns;
+    double sum_ns;
+    double scan_ns;
+};
+
+/*=======================================================================================*/
+
+template <typename list_t>
+static list_error_t bench_layout   (size_t           elements_number,
+                                    layout_result_t *result);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+static void         print_result   (const char            *name,
+                                    size_t                 elements_number,
+                                    const layout_result_t *result);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t elements_number = default_elements_number;
+    if(argc > 1) {
+        elements_number = strtoull(argv[1], NULL, 10);
+    }
+
+    layout_result_t aos = {};
+    layout_result_t soa = {};
+
+    if(bench_layout<linked_list_t    >(elements_number, &aos) != LINKED_LIST_SUCCESS ||
+       bench_layout<soa_linked_list_t>(elements_number, &soa) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    printf("%-6s | %12s | %12s | %12s | %12s\n",
+           "layout", "fill ns/op", "walk ns/op", "sum ns/op", "scan ns/op");
+    print_result("aos", elements_number, &aos);
+    print_result("soa", elements_number, &soa);
+    return EXIT_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t bench_layout(size_t elements_number, layout_result_t *result) {
+    typedef typename list_t::elem_type elem_t;
+
+    list_t list = {};
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(&list, 1)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    /* Fill, then churn the middle so the next chain jumps across the array. */
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t element = 0; element < elements_number; element++) {
+        if((error_code = linked_list_insert_before(&list, 0, (elem_t)element)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+    result->fill_ns = nanoseconds_since(start) / (double)elements_number;
+
+    srand(211);
+    for(size_t round = 0; round < churn_rounds; round++) {
+        for(size_t element = 0; element < elements_number / 8; element++) {
+            size_t node = 1 + (size_t)rand() % list.capacity;
+            if(linked_list_prev(&list, node) == list_index_traits_t<typename list_t::index_type>::poison) {
+                continue;
+            }
+            elem_t removed = 0;
+            linked_list_remove       (&list, node, &removed);
+            linked_list_insert_before(&list, linked_list_next(&list, 0), removed);
+        }
+    }
+
+    start = std::chrono::steady_clock::now();
+    size_t visited = 0;
+    for(size_t node = linked_list_next(&list, 0); node != 0; node = linked_list_next(&list, node)) {
+        visited++;
+    }
+    result->walk_ns = nanoseconds_since(start) / (double)visited;
+
+    start = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for(size_t node = linked_list_next(&list, 0); node != 0; node = linked_list_next(&list, node)) {
+        sum += linked_list_data(&list, node);
+    }
+    result->sum_ns = nanoseconds_since(start) / (double)visited;
+
+    start = std::chrono::steady_clock::now();
+    size_t matches = 0;
+    for(size_t node = 1; node < list.capacity + 1; node++) {
+        if(linked_list_data(&list, node) % 7 == 3) {
+            matches++;
+        }
+    }
+    result->scan_ns = nanoseconds_since(start) / (double)(list.capacity + 1);
+
+    /* Keeps the loops from being optimized away. */
+    if(visited != list.size || (sum == 0 && matches == (size_t)-1)) {
+        return LINKED_LIST_LOOP_ERROR;
+    }
+
+    return linked_list_dtor(&list);
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
+
+/*=======================================================================================*/
+
+void print_result(const char *name, size_t elements_number, const layout_result_t *result) {
+    printf("%-6s | %12.2f | %12.2f | %12.2f | %12.2f   (%zu elements)\n",
+           name,
+           result->fill_ns,
+           result->walk_ns,
+           result->sum_ns,
+           result->scan_ns,
+           elements_number);
+}
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_nodes_number = 1 << 22;
+static const size_t max_threads_number   = 16;
+
+/*=======================================================================================*/
+
+static list_error_t build_scattered  (linked_list_t *list,
+                                      size_t         nodes_number);
+static double       export_serial    (linked_list_t *list,
+                                      data_t        *output);
+static double       export_parallel  (linked_list_t *list,
+                                      data_t        *output,
+                                      size_t         threads_number);
+static double       rank_parallel    (linked_list_t *list,
+                                      size_t        *positions,
+                                      size_t         threads_number);
+static bool         check_ranks      (linked_list_t *list,
+                                      const size_t  *positions);
+static bool         check_reduce     (linked_list_t *list,
+                                      const data_t  *expected);
+static double       seconds_since    (std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    linked_list_t list = {};
+    if(build_scattered(&list, nodes_number) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    data_t *expected  = (data_t *)calloc(nodes_number,      sizeof(data_t));
+    data_t *output    = (data_t *)calloc(nodes_number,      sizeof(data_t));
+    size_t *positions = (size_t *)calloc(list.capacity + 1, sizeof(size_t));
+    if(expected == NULL || output == NULL || positions == NULL) {
+        free(expected);
+        free(output);
+        free(positions);
+        linked_list_dtor(&list);
+        return EXIT_FAILURE;
+    }
+
+    printf("scattered chain of %zu nodes, %u hardware threads\n",
+           nodes_number, std::thread::hardware_concurrency());
+    double serial = export_serial(&list, expected);
+    printf("%-8s | %14s | %14s | %s\n", "threads", "export ns/node", "rank ns/node", "check");
+    printf("%-8s | %14.2f | %14s | %s\n", "serial", serial * 1e9 / (double)nodes_number, "-", "-");
+
+    bool all_passed = check_reduce(&list, expected);
+    for(size_t threads_number = 1; threads_number <= max_threads_number; threads_number *= 2) {
+        memset(output, 0, nodes_number * sizeof(data_t));
+        double exported = export_parallel(&list, output, threads_number);
+        double ranked   = rank_parallel  (&list, positions, threads_number);
+        bool   passed   = memcmp(output, expected, nodes_number * sizeof(data_t)) == 0 &&
+                          check_ranks(&list, positions);
+        printf("%-8zu | %14.2f | %14.2f | %s\n",
+               threads_number,
+               exported * 1e9 / (double)nodes_number,
+               ranked   * 1e9 / (double)nodes_number,
+               passed ? "ok" : "FAILED");
+        all_passed = all_passed && passed;
+    }
+
+    free(expected);
+    free(output);
+    free(positions);
+    linked_list_dtor(&list);
+    return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Every node goes after a random earlier one, so neighbours in the */
+/* chain are far apart in the array.                                 */
+list_error_t build_scattered(linked_list_t *list, size_t nodes_number) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(list, nodes_number)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    for(size_t node = 0; node < nodes_number; node++) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        size_t after = node == 0 ? 0 : (size_t)(random % node) + 1;
+        if((error_code = linked_list_insert_after(list, after, (data_t)(random & 0xffff))) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* What callers write today. */
+double export_serial(linked_list_t *list, data_t *output) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t position = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        output[position++] = linked_list_data(list, node);
+    }
+    return seconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double export_parallel(linked_list_t *list, data_t *output, size_t threads_number) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(linked_list_parallel_export(list, output, threads_number) != LINKED_LIST_SUCCESS) {
+        return 0;
+    }
+    return seconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double rank_parallel(linked_list_t *list, size_t *positions, size_t threads_number) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(linked_list_rank(list, positions, threads_number) != LINKED_LIST_SUCCESS) {
+        return 0;
+    }
+    return seconds_since(start);
+}
+
+/*=======================================================================================*/
+
+bool check_ranks(linked_list_t *list, const size_t *positions) {
+    size_t position = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        if(positions[node] != position++) {
+            return false;
+        }
+    }
+    return positions[0] == SIZE_MAX;
+}
+
+/*=======================================================================================*/
+
+/* Polynomial hash, which only matches if partials are folded in order. */
+bool check_reduce(linked_list_t *list, const data_t *expected) {
+    typedef std::pair<uint64_t, uint64_t> hash_t;
+
+    uint64_t serial = 0;
+    for(size_t position = 0; position < list->size; position++) {
+        serial = serial * 31 + (uint64_t)expected[position];
+    }
+
+    /* A hash is (value, 31^length), so two hashes join associatively. */
+    hash_t result(0, 1);
+    linked_list_parallel_reduce(list, hash_t(0, 1),
+        [](hash_t hash, data_t value) {
+            return hash_t(hash.first * 31 + (uint64_t)value, hash.second * 31);
+        },
+        [](hash_t left, hash_t right) {
+            return hash_t(left.first * right.second + right.first, left.second * right.second);
+        }, &result, 4);
+    return result.first == serial;
+}
+
+/*=======================================================================================*/
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_lists_number = 1 << 15;
+static const size_t elements_per_list    = 8;
+static const size_t rounds_number        = 8;
+
+/*=======================================================================================*/
+
+struct pool_result_t {
+    double build_ns;
+    double walk_ns;
+    double destroy_ns;
+};
+
+/*=======================================================================================*/
+
+static list_error_t bench_private  (size_t         lists_number,
+                                    pool_result_t *result);
+static list_error_t bench_pooled   (size_t         lists_number,
+                                    pool_result_t *result);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+static void         print_result   (const char          *name,
+                                    size_t               lists_number,
+                                    const pool_result_t *result);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t lists_number = default_lists_number;
+    if(argc > 1) {
+        lists_number = strtoull(argv[1], NULL, 10);
+    }
+
+    pool_result_t private_lists = {};
+    pool_result_t pooled_lists  = {};
+
+    if(bench_private(lists_number, &private_lists) != LINKED_LIST_SUCCESS ||
+       bench_pooled (lists_number, &pooled_lists ) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s | %14s | %14s | %16s\n",
+           "lists", "build ns/list", "walk ns/list", "destroy ns/list");
+    print_result("private", lists_number, &private_lists);
+    print_result("pooled",  lists_number, &pooled_lists );
+    return EXIT_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Every list owns its array, as linked_list_ctor makes them. */
+list_error_t bench_private(size_t lists_number, pool_result_t *result) {
+    linked_list_t *lists = (linked_list_t *)calloc(lists_number, sizeof(linked_list_t));
+    if(lists == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    long long    sum        = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            if((error_code = linked_list_ctor(&lists[list], 1)) != LINKED_LIST_SUCCESS) {
+                return error_code;
+            }
+            for(size_t element = 0; element < elements_per_list; element++) {
+                linked_list_insert_before(&lists[list], 0, (data_t)element);
+            }
+        }
+        result->build_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            for(size_t node = linked_list_next(&lists[list], 0);
+                node != 0;
+                node = linked_list_next(&lists[list], node)) {
+                sum += linked_list_data(&lists[list], node);
+            }
+        }
+        result->walk_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            linked_list_dtor(&lists[list]);
+        }
+        result->destroy_ns += nanoseconds_since(start);
+    }
+
+    free(lists);
+    result->build_ns   /= (double)(lists_number * rounds_number);
+    result->walk_ns    /= (double)(lists_number * rounds_number);
+    result->destroy_ns /= (double)(lists_number * rounds_number);
+    return sum == 0 ? LINKED_LIST_LOOP_ERROR : LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* All lists draw their nodes and sentinels from one pool. */
+list_error_t bench_pooled(size_t lists_number, pool_result_t *result) {
+    pooled_linked_list_t *lists = (pooled_linked_list_t *)calloc(lists_number, sizeof(pooled_linked_list_t));
+    if(lists == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    linked_list_t pool       = {};
+    list_error_t  error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(&pool, 1)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    long long sum = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            if((error_code = pooled_list_ctor(&lists[list], &pool)) != LINKED_LIST_SUCCESS) {
+                return error_code;
+            }
+            for(size_t element = 0; element < elements_per_list; element++) {
+                pooled_list_insert_before(&lists[list], lists[list].sentinel, (data_t)element);
+            }
+        }
+        result->build_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            for(size_t node = linked_list_next(&pool, lists[list].sentinel);
+                node != lists[list].sentinel;
+                node = linked_list_next(&pool, node)) {
+                sum += linked_list_data(&pool, node);
+            }
+        }
+        result->walk_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        for(size_t list = 0; list < lists_number; list++) {
+            pooled_list_dtor(&lists[list]);
+        }
+        result->destroy_ns += nanoseconds_since(start);
+    }
+
+    linked_list_dtor(&pool);
+    free(lists);
+    result->build_ns   /= (double)(lists_number * rounds_number);
+    result->walk_ns    /= (double)(lists_number * rounds_number);
+    result->destroy_ns /= (double)(lists_number * rounds_number);
+    return sum == 0 ? LINKED_LIST_LOOP_ERROR : LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
+
+/*=======================================================================================*/
+
+void print_result(const char *name, size_t lists_number, const pool_result_t *result) {
+    printf("%-8s | %14.2f | %14.2f | %16.2f   (%zu lists of %zu)\n",
+           name,
+           result->build_ns,
+           result->walk_ns,
+           result->destroy_ns,
+           lists_number,
+           elements_per_list);
+}
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_messages_number = 1 << 24;
+static const size_t queue_capacity          = 1 << 12;
+static const size_t max_producers_number    = 8;
+
+/*=======================================================================================*/
+
+/* The channel callers build today: a deque behind one mutex. */
+struct locked_queue_t {
+    std::mutex       mutex;
+    std::deque<int>  deque;
+};
+
+/*=======================================================================================*/
+
+static void   produce        (list_queue_t   *queue,
+                              int             producer,
+                              size_t          messages_number);
+static bool   consume        (list_queue_t   *queue,
+                              size_t          messages_number,
+                              size_t          producers_number);
+static void   produce_locked (locked_queue_t *queue,
+                              int             producer,
+                              size_t          messages_number);
+static bool   consume_locked (locked_queue_t *queue,
+                              size_t          messages_number,
+                              size_t          producers_number);
+static double bench_queue    (list_queue_mode_t mode,
+                              size_t            producers_number,
+                              size_t            messages_number,
+                              bool             *passed);
+static double bench_locked   (size_t            producers_number,
+                              size_t            messages_number,
+                              bool             *passed);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t messages_number = default_messages_number;
+    if(argc > 1) {
+        messages_number = strtoull(argv[1], NULL, 10);
+    }
+
+    printf("%-10s | %18s | %18s | %s\n", "producers", "locked Mmsg/s", "queue Mmsg/s", "order");
+    bool all_passed = true;
+    for(size_t producers_number = 1; producers_number <= max_producers_number; producers_number *= 2) {
+        list_queue_mode_t mode = producers_number == 1 ? LINKED_LIST_QUEUE_SPSC : LINKED_LIST_QUEUE_MPSC;
+        bool   locked_passed = false;
+        bool   queue_passed  = false;
+        double locked = bench_locked(producers_number, messages_number, &locked_passed);
+        double queue  = bench_queue (mode, producers_number, messages_number, &queue_passed);
+        printf("%-10zu | %18.2f | %18.2f | %s (%s)\n",
+               producers_number,
+               (double)messages_number / locked / 1e6,
+               (double)messages_number / queue  / 1e6,
+               locked_passed && queue_passed ? "ok" : "FAILED",
+               mode == LINKED_LIST_QUEUE_SPSC ? "spsc" : "mpsc");
+        all_passed = all_passed && locked_passed && queue_passed;
+    }
+    return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Messages carry the producer in the high byte and a counter below it, */
+/* the consumer checks that every producer's messages come in order.    */
+void produce(list_queue_t *queue, int producer, size_t messages_number) {
+    for(size_t message = 0; message < messages_number; message++) {
+        int value = producer << 24 | (int)message;
+        while(list_queue_try_push(queue, value) == LINKED_LIST_QUEUE_FULL) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+bool consume(list_queue_t *queue, size_t messages_number, size_t producers_number) {
+    int  expected[max_producers_number] = {};
+    bool ordered                        = true;
+    for(size_t message = 0; message < messages_number * producers_number; message++) {
+        int value = 0;
+        while(list_queue_try_pop(queue, &value) == LINKED_LIST_QUEUE_EMPTY) {
+            std::this_thread::yield();
+        }
+        int producer = value >> 24;
+        ordered = ordered && (value & 0xffffff) == (expected[producer] & 0xffffff);
+        expected[producer]++;
+    }
+    return ordered;
+}
+
+/*=======================================================================================*/
+
+void produce_locked(locked_queue_t *queue, int producer, size_t messages_number) {
+    for(size_t message = 0; message < messages_number; message++) {
+        int value = producer << 24 | (int)message;
+        while(true) {
+            {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                if(queue->deque.size() < queue_capacity) {
+                    queue->deque.push_back(value);
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+bool consume_locked(locked_queue_t *queue, size_t messages_number, size_t producers_number) {
+    int  expected[max_producers_number] = {};
+    bool ordered                        = true;
+    for(size_t message = 0; message < messages_number * producers_number; message++) {
+        int value = 0;
+        while(true) {
+            {
+                std::lock_guard<std::mutex> lock(queue->mutex);
+                if(!queue->deque.empty()) {
+                    value = queue->deque.front();
+                    queue->deque.pop_front();
+                    break;
+                }
+            }
+            std::this_thread::yield();
+        }
+        int producer = value >> 24;
+        ordered = ordered && (value & 0xffffff) == (expected[producer] & 0xffffff);
+        expected[producer]++;
+    }
+    return ordered;
+}
+
+/*=======================================================================================*/
+
+double bench_queue(list_queue_mode_t mode, size_t producers_number, size_t messages_number, bool *passed) {
+    list_queue_t *queue = new list_queue_t();
+    if(list_queue_ctor(queue, queue_capacity, mode) != LINKED_LIST_SUCCESS) {
+        delete queue;
+        *passed = false;
+        return 1;
+    }
+
+    size_t       per_producer = messages_number / producers_number;
+    std::thread *producers    = new std::thread[producers_number];
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t producer = 0; producer < producers_number; producer++) {
+        producers[producer] = std::thread(produce, queue, (int)producer, per_producer);
+    }
+    *passed = consume(queue, per_producer, producers_number);
+    for(size_t producer = 0; producer < producers_number; producer++) {
+        producers[producer].join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    delete[] producers;
+    list_queue_dtor(queue);
+    delete queue;
+    return seconds;
+}
+
+/*=======================================================================================*/
+
+double bench_locked(size_t producers_number, size_t messages_number, bool *passed) {
+    locked_queue_t *queue        = new locked_queue_t();
+    size_t          per_producer = messages_number / producers_number;
+    std::thread    *producers    = new std::thread[producers_number];
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t producer = 0; producer < producers_number; producer++) {
+        producers[producer] = std::thread(produce_locked, queue, (int)producer, per_producer);
+    }
+    *passed = consume_locked(queue, per_producer, producers_number);
+    for(size_t producer = 0; producer < producers_number; producer++) {
+        producers[producer].join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    delete[] producers;
+    delete queue;
+    return seconds;
+}
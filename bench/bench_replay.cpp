@@ -0,0 +1,378 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+/* Replays a trace written by linked_list_trace_start against this build of */
+/* the library. The trace is decoded up front, then run rounds_number times */
+/* at full speed for throughput and once more timing every operation.       */
+static const size_t default_rounds_number = 5;
+
+static const double percentiles[]   = {0.5, 0.9, 0.99, 0.999};
+static const char  *op_names[]      = {"", "ctor", "insert_after", "insert_before", "remove", "dtor",
+                                       "range_after", "range_before", "range_node", "remove_range",
+                                       "clear", "linearize", "shrink", "sort", "relink"};
+static const size_t op_names_number = sizeof(op_names) / sizeof(op_names[0]);
+
+/* Recorded real indices of a list are mapped to the ones it gets here. */
+/* values gathers the payloads of a range insert.                        */
+struct replay_list_t {
+    linked_list_t       list;
+    std::vector<size_t> slots;
+    std::vector<data_t> values;
+    bool                alive;
+};
+
+/*=======================================================================================*/
+
+static list_error_t read_trace    (const char                       *path,
+                                   std::vector<list_trace_record_t> *records,
+                                   size_t                           *lists_number);
+static list_error_t gather_ranges (std::vector<list_trace_record_t> *records);
+static list_error_t replay        (const std::vector<list_trace_record_t> &records,
+                                   size_t                                  lists_number,
+                                   std::vector<double>                    *latencies);
+static list_error_t replay_record (std::vector<replay_list_t> *lists,
+                                   const list_trace_record_t  *record);
+static list_error_t replay_range  (replay_list_t              *replayed,
+                                   const list_trace_record_t  *record);
+static void         map_linear    (replay_list_t              *replayed);
+static void         print_latency (const char                 *name,
+                                   std::vector<double>        *latencies);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    if(argc < 2) {
+        printf("usage: %s trace [rounds]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    size_t rounds_number = default_rounds_number;
+    if(argc > 2) {
+        rounds_number = strtoull(argv[2], NULL, 10);
+    }
+
+    std::vector<list_trace_record_t> records;
+    size_t lists_number = 0;
+    if(read_trace(argv[1], &records, &lists_number) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    printf("%s: %zu operations on %zu lists\n", argv[1], records.size(), lists_number);
+
+    double best = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if(replay(records, lists_number, NULL) != LINKED_LIST_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        double nanoseconds = nanoseconds_since(start);
+        best = round == 0 || nanoseconds < best ? nanoseconds : best;
+    }
+    if(rounds_number != 0) {
+        printf("best of %zu rounds: %.1f ms, %.2f Mops/s\n",
+               rounds_number, best / 1e6, (double)records.size() / best * 1e3);
+    }
+
+    std::vector<double> latencies[op_names_number];
+    if(replay(records, lists_number, latencies) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+    printf("%-14s | %10s | %8s | %8s | %8s | %8s | %10s\n",
+           "latency, ns", "count", "p50", "p90", "p99", "p99.9", "max");
+    for(size_t op = 1; op < op_names_number; op++) {
+        print_latency(op_names[op], &latencies[op]);
+    }
+    return EXIT_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+list_error_t read_trace(const char                       *path,
+                        std::vector<list_trace_record_t> *records,
+                        size_t                           *lists_number) {
+    FILE *file = fopen(path, "rb");
+    if(file == NULL) {
+        printf("can not open '%s'\n", path);
+        return LINKED_LIST_FILE_ERROR;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t block[1 << 12] = {};
+    size_t  read_size      = 0;
+    while((read_size = fread(block, 1, sizeof(block), file)) != 0) {
+        bytes.insert(bytes.end(), block, block + read_size);
+    }
+    fclose(file);
+
+    if(bytes.size() < list_trace_magic_size ||
+       !std::equal(bytes.begin(), bytes.begin() + (long)list_trace_magic_size, list_trace_magic)) {
+        printf("'%s' is not a list trace\n", path);
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    const uint8_t *cursor = bytes.data() + list_trace_magic_size;
+    const uint8_t *end    = bytes.data() + bytes.size();
+    *lists_number = 0;
+    while(cursor != end) {
+        list_trace_record_t record = {};
+        if(list_trace_read(&cursor, end, &record) != LINKED_LIST_SUCCESS) {
+            printf("'%s' is damaged after %zu records\n", path, records->size());
+            return LINKED_LIST_FILE_ERROR;
+        }
+        if(record.op == LIST_TRACE_RELINK) {
+            printf("'%s' sorts a list with its own comparator, which can not be replayed\n", path);
+            return LINKED_LIST_FILE_ERROR;
+        }
+        records->push_back(record);
+        *lists_number = std::max(*lists_number, record.list + 1);
+    }
+    if(gather_ranges(records) != LINKED_LIST_SUCCESS) {
+        printf("'%s' has a range insert with missing nodes\n", path);
+        return LINKED_LIST_FILE_ERROR;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Records of other threads may fall between a range insert and its nodes, */
+/* so the nodes are moved right behind the insert they belong to.          */
+list_error_t gather_ranges(std::vector<list_trace_record_t> *records) {
+    std::vector<list_trace_record_t> ordered;
+    std::vector<bool>                taken(records->size(), false);
+    ordered.reserve(records->size());
+
+    for(size_t record = 0; record < records->size(); record++) {
+        const list_trace_record_t *current = &(*records)[record];
+        if(current->op == LIST_TRACE_RANGE_NODE) {
+            if(!taken[record]) {
+                return LINKED_LIST_FILE_ERROR;
+            }
+            continue;
+        }
+        ordered.push_back(*current);
+        if(current->op != LIST_TRACE_INSERT_RANGE_AFTER && current->op != LIST_TRACE_INSERT_RANGE_BEFORE) {
+            continue;
+        }
+
+        size_t nodes_number = (size_t)current->value;
+        for(size_t node = record + 1; node < records->size() && nodes_number != 0; node++) {
+            if((*records)[node].op == LIST_TRACE_RANGE_NODE && (*records)[node].list == current->list) {
+                ordered.push_back((*records)[node]);
+                taken[node] = true;
+                nodes_number--;
+            }
+        }
+        if(nodes_number != 0) {
+            return LINKED_LIST_FILE_ERROR;
+        }
+    }
+    records->swap(ordered);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Lists still alive at the end of the trace are destroyed untimed. */
+list_error_t replay(const std::vector<list_trace_record_t> &records,
+                    size_t                                  lists_number,
+                    std::vector<double>                    *latencies) {
+    std::vector<replay_list_t> lists(lists_number, replay_list_t{linked_list_t{}, {}, {}, false});
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    for(size_t record = 0; record < records.size() && error_code == LINKED_LIST_SUCCESS; record++) {
+        if(latencies == NULL) {
+            error_code = replay_record(&lists, &records[record]);
+            continue;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        error_code = replay_record(&lists, &records[record]);
+        if(records[record].op != LIST_TRACE_RANGE_NODE) {
+            latencies[records[record].op].push_back(nanoseconds_since(start));
+        }
+    }
+    if(error_code != LINKED_LIST_SUCCESS) {
+        printf("operation failed with error %d, the trace does not fit this library\n", error_code);
+    }
+
+    for(size_t list = 0; list < lists_number; list++) {
+        if(lists[list].alive) {
+            linked_list_dtor(&lists[list].list);
+        }
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+/* The nodes of a range insert follow it in records and are consumed by it. */
+list_error_t replay_record(std::vector<replay_list_t> *lists, const list_trace_record_t *record) {
+    replay_list_t *replayed = &(*lists)[record->list];
+    if(record->op != LIST_TRACE_CTOR &&
+       (!replayed->alive || (record->op != LIST_TRACE_DTOR && record->op != LIST_TRACE_SORT &&
+                             record->index >= replayed->slots.size()))) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    switch(record->op) {
+        case LIST_TRACE_CTOR: {
+            if(replayed->alive) {
+                return LINKED_LIST_INVALID_INDEX;
+            }
+            replayed->alive = true;
+            replayed->slots.assign(1, 0);
+            return linked_list_ctor(&replayed->list, record->index);
+        }
+        case LIST_TRACE_INSERT_AFTER:
+        case LIST_TRACE_INSERT_BEFORE: {
+            size_t anchor = replayed->slots[record->index];
+            size_t slot   = 0;
+            if(record->op == LIST_TRACE_INSERT_AFTER) {
+                error_code = linked_list_insert_after(&replayed->list, anchor, (data_t)record->value);
+                slot       = linked_list_next(&replayed->list, anchor);
+            }
+            else {
+                error_code = linked_list_insert_before(&replayed->list, anchor, (data_t)record->value);
+                slot       = linked_list_prev(&replayed->list, anchor);
+            }
+            if(record->slot >= replayed->slots.size()) {
+                replayed->slots.resize(record->slot + 1);
+            }
+            replayed->slots[record->slot] = slot;
+            return error_code;
+        }
+        case LIST_TRACE_REMOVE: {
+            data_t removed = 0;
+            return linked_list_remove(&replayed->list, replayed->slots[record->index], &removed);
+        }
+        case LIST_TRACE_DTOR: {
+            replayed->alive = false;
+            return linked_list_dtor(&replayed->list);
+        }
+        case LIST_TRACE_INSERT_RANGE_AFTER:
+        case LIST_TRACE_INSERT_RANGE_BEFORE: {
+            return replay_range(replayed, record);
+        }
+        case LIST_TRACE_RANGE_NODE: {
+            return LINKED_LIST_SUCCESS;
+        }
+        case LIST_TRACE_REMOVE_RANGE: {
+            if(record->slot >= replayed->slots.size()) {
+                return LINKED_LIST_INVALID_INDEX;
+            }
+            return linked_list_remove_range(&replayed->list,
+                                            replayed->slots[record->index],
+                                            replayed->slots[record->slot]);
+        }
+        case LIST_TRACE_CLEAR: {
+            replayed->slots.assign(1, 0);
+            return linked_list_clear(&replayed->list);
+        }
+        case LIST_TRACE_LINEARIZE: {
+            error_code = linked_list_linearize(&replayed->list);
+            map_linear(replayed);
+            return error_code;
+        }
+        case LIST_TRACE_SHRINK: {
+            error_code = linked_list_shrink_to_fit(&replayed->list);
+            map_linear(replayed);
+            return error_code;
+        }
+        case LIST_TRACE_SORT: {
+            /* Nodes only relinked there are only relinked here, the same way. */
+            if(record->index == 0) {
+                return linked_list_sort(&replayed->list, [](const data_t &left, const data_t &right) {
+                    return left < right;
+                });
+            }
+            if((error_code = linked_list_sort(&replayed->list)) == LINKED_LIST_SUCCESS) {
+                error_code = linked_list_linearize(&replayed->list);
+            }
+            map_linear(replayed);
+            return error_code;
+        }
+        case LIST_TRACE_RELINK:
+        default: {
+            return LINKED_LIST_INVALID_INDEX;
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+list_error_t replay_range(replay_list_t *replayed, const list_trace_record_t *record) {
+    size_t nodes_number = (size_t)record->value;
+    size_t anchor       = replayed->slots[record->index];
+
+    replayed->values.resize(nodes_number);
+    for(size_t node = 0; node < nodes_number; node++) {
+        replayed->values[node] = (data_t)record[node + 1].value;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    size_t       before     = 0;
+    if(record->op == LIST_TRACE_INSERT_RANGE_AFTER) {
+        before     = anchor;
+        error_code = linked_list_insert_range_after(&replayed->list, anchor,
+                                                    replayed->values.data(), nodes_number);
+    }
+    else {
+        before     = linked_list_prev(&replayed->list, anchor);
+        error_code = linked_list_insert_range_before(&replayed->list, anchor,
+                                                     replayed->values.data(), nodes_number);
+    }
+    if(error_code != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    size_t slot = linked_list_next(&replayed->list, before);
+    for(size_t node = 1; node <= nodes_number; node++) {
+        if(record[node].slot >= replayed->slots.size()) {
+            replayed->slots.resize(record[node].slot + 1);
+        }
+        replayed->slots[record[node].slot] = slot;
+        slot = linked_list_next(&replayed->list, slot);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Both lists hold position p in slot p + 1 now. */
+void map_linear(replay_list_t *replayed) {
+    replayed->slots.resize(replayed->list.size + 1);
+    for(size_t slot = 0; slot < replayed->slots.size(); slot++) {
+        replayed->slots[slot] = slot;
+    }
+}
+
+/*=======================================================================================*/
+
+/* Percentiles include the ~20 ns the clock itself takes. */
+void print_latency(const char *name, std::vector<double> *latencies) {
+    if(latencies->empty()) {
+        return;
+    }
+    std::sort(latencies->begin(), latencies->end());
+
+    size_t count = latencies->size();
+    printf("%-14s | %10zu", name, count);
+    for(size_t percentile = 0; percentile < sizeof(percentiles) / sizeof(percentiles[0]); percentile++) {
+        size_t rank = (size_t)(percentiles[percentile] * (double)count);
+        printf(" | %8.0f", (*latencies)[std::min(rank, count - 1)]);
+    }
+    printf(" | %10.0f\n", latencies->back());
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
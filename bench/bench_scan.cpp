@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_nodes_number = 1 << 22;
+static const size_t rounds_number        = 8;
+/* Every removed_every-th node is removed after building, so about */
+/* a quarter of the slots are dead and scattered over the array.   */
+static const size_t removed_every        = 4;
+
+/*=======================================================================================*/
+
+template <typename list_t>
+static list_error_t build_churned (list_t *list,
+                                   size_t  nodes_number);
+template <typename list_t>
+static bool         bench_list    (const char *name,
+                                   list_t     *list);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    #if defined(LINKED_LIST_SIMD_AVX2)
+        const char *kernel = "avx2";
+    #elif defined(LINKED_LIST_SIMD_SSE2)
+        const char *kernel = "sse2";
+    #else
+        const char *kernel = "scalar";
+    #endif
+    printf("churned lists of %zu nodes, %s kernels\n", nodes_number, kernel);
+    printf("%-8s | %-6s | %12s | %12s\n", "layout", "query", "walk ns/node", "scan ns/node");
+
+    linked_list_t     list     = {};
+    soa_linked_list_t soa_list = {};
+    if(build_churned(&list,     nodes_number) != LINKED_LIST_SUCCESS ||
+       build_churned(&soa_list, nodes_number) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    bool passed = bench_list("aos", &list) && bench_list("soa", &soa_list);
+    linked_list_dtor(&list);
+    linked_list_dtor(&soa_list);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Random insertion points scatter the chain, the removals leave holes. */
+template <typename list_t>
+list_error_t build_churned(list_t *list, size_t nodes_number) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(list, nodes_number)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    for(size_t node = 0; node < nodes_number; node++) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        size_t after = node == 0 ? 0 : (size_t)(random % node) + 1;
+        if((error_code = linked_list_insert_after(list, after, (data_t)(random % 1000000))) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+
+    for(size_t node = removed_every; node <= nodes_number; node += removed_every) {
+        data_t removed = 0;
+        if((error_code = linked_list_remove(list, node, &removed)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* The walks are what callers write today, both sides must agree. */
+template <typename list_t>
+bool bench_list(const char *name, list_t *list) {
+    const data_t missing = -2;
+    double       nodes   = (double)(list->size * rounds_number);
+    bool         passed  = true;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t walk_found = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+            if(linked_list_data(list, node) == missing) {
+                walk_found = node;
+                break;
+            }
+        }
+    }
+    double walk = nanoseconds_since(start);
+    start = std::chrono::steady_clock::now();
+    size_t scan_found = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        linked_list_find(list, missing, &scan_found);
+    }
+    printf("%-8s | %-6s | %12.2f | %12.2f\n", name, "find", walk / nodes, nanoseconds_since(start) / nodes);
+    passed = passed && walk_found == scan_found;
+
+    start = std::chrono::steady_clock::now();
+    long long walk_sum = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+            walk_sum += linked_list_data(list, node);
+        }
+    }
+    walk = nanoseconds_since(start);
+    start = std::chrono::steady_clock::now();
+    long long scan_sum = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        long long sum = 0;
+        linked_list_sum(list, &sum);
+        scan_sum += sum;
+    }
+    printf("%-8s | %-6s | %12.2f | %12.2f\n", name, "sum", walk / nodes, nanoseconds_since(start) / nodes);
+    passed = passed && walk_sum == scan_sum;
+
+    start = std::chrono::steady_clock::now();
+    data_t walk_min = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        walk_min = linked_list_data(list, linked_list_next(list, 0));
+        for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+            walk_min = linked_list_data(list, node) < walk_min ? linked_list_data(list, node) : walk_min;
+        }
+    }
+    walk = nanoseconds_since(start);
+    start = std::chrono::steady_clock::now();
+    size_t scan_min = 0;
+    for(size_t round = 0; round < rounds_number; round++) {
+        linked_list_min(list, &scan_min);
+    }
+    printf("%-8s | %-6s | %12.2f | %12.2f\n", name, "min", walk / nodes, nanoseconds_since(start) / nodes);
+    passed = passed && linked_list_data(list, scan_min) == walk_min;
+
+    if(!passed) {
+        printf("%s: scan results differ from the walk\n", name);
+    }
+    return passed;
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_nodes_number = 1 << 22;
+
+/*=======================================================================================*/
+
+static list_error_t build_scattered   (linked_list_t *list,
+                                       size_t         nodes_number);
+static double       sort_drained      (linked_list_t *list);
+static double       sort_comparator   (linked_list_t *list);
+static double       sort_radix        (linked_list_t *list);
+static bool         is_sorted         (linked_list_t *list,
+                                       size_t         nodes_number);
+static double       milliseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    printf("scattered chain of %zu nodes\n", nodes_number);
+    printf("%-24s | %10s | %s\n", "sort", "ms", "check");
+
+    double (*sorts[])(linked_list_t *) = {sort_drained, sort_comparator, sort_radix};
+    const char *names[]                = {"drain, std::sort, refill", "comparator, relinked", "radix, linearized"};
+
+    bool all_passed = true;
+    for(size_t sort = 0; sort < sizeof(sorts) / sizeof(sorts[0]); sort++) {
+        linked_list_t list = {};
+        if(build_scattered(&list, nodes_number) != LINKED_LIST_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        double milliseconds = sorts[sort](&list);
+        bool   passed       = is_sorted(&list, nodes_number);
+        printf("%-24s | %10.1f | %s\n", names[sort], milliseconds, passed ? "ok" : "FAILED");
+        all_passed = all_passed && passed;
+        linked_list_dtor(&list);
+    }
+    return all_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Every node goes after a random earlier one, so neighbours in the */
+/* chain are far apart in the array.                                 */
+list_error_t build_scattered(linked_list_t *list, size_t nodes_number) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(list, nodes_number)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    for(size_t node = 0; node < nodes_number; node++) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        size_t after = node == 0 ? 0 : (size_t)(random % node) + 1;
+        if((error_code = linked_list_insert_after(list, after, (data_t)(random >> 33) - (1 << 30))) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* What callers do today. */
+double sort_drained(linked_list_t *list) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    size_t  size   = list->size;
+    data_t *values = (data_t *)calloc(size, sizeof(data_t));
+    if(values == NULL) {
+        return 0;
+    }
+    size_t position = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        values[position++] = linked_list_data(list, node);
+    }
+    std::sort(values, values + size);
+
+    linked_list_clear(list);
+    for(size_t value = 0; value < size; value++) {
+        linked_list_insert_before(list, 0, values[value]);
+    }
+    free(values);
+    return milliseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double sort_comparator(linked_list_t *list) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    linked_list_sort(list, [](const data_t &left, const data_t &right) {
+        return left < right;
+    });
+    return milliseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double sort_radix(linked_list_t *list) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    linked_list_sort(list);
+    return milliseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+bool is_sorted(linked_list_t *list, size_t nodes_number) {
+    size_t walked = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        size_t next = linked_list_next(list, node);
+        if(next != 0 && linked_list_data(list, next) < linked_list_data(list, node)) {
+            return false;
+        }
+        walked++;
+    }
+    return walked == nodes_number && list->size == nodes_number;
+}
+
+/*=======================================================================================*/
+
+double milliseconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
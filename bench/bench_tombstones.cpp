@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+/* A list of nodes_number nodes is shuffled by churn, then evicted in bursts  */
+/* of burst_share of its size, each followed by a walk with for_each and a   */
+/* refill back to full size. Eager removal is compared with deferred removal */
+/* compacting on its own and with a compaction after every burst.            */
+static const size_t default_nodes_number = 1 << 20;
+static const size_t burst_share          = 8;
+static const size_t bursts_number        = 16;
+static const size_t auto_compact_percent = 25;
+
+enum bench_mode_t {
+    BENCH_EAGER          = 0,
+    BENCH_DEFERRED_AUTO  = 1,
+    BENCH_DEFERRED_BURST = 2,
+};
+
+static const char *mode_names[] = {"eager", "deferred", "per burst"};
+
+/*=======================================================================================*/
+
+static bool   bench_mode       (bench_mode_t         mode,
+                                size_t               nodes_number,
+                                long long           *sum);
+static bool   build            (linked_list_t       *list,
+                                std::vector<size_t> *live,
+                                size_t               nodes_number);
+static size_t random_below     (size_t               bound,
+                                uint64_t            *random);
+static double nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    printf("%zu nodes, %zu bursts evicting 1/%zu of them\n", nodes_number, bursts_number, burst_share);
+    printf("%-10s | %13s | %13s | %13s\n", "mode", "remove ns/op", "compact ns/op", "walk ns/node");
+
+    /* Every walk sees the same live payloads in every mode. */
+    long long sums[3] = {};
+    bool passed = bench_mode(BENCH_EAGER,          nodes_number, &sums[0]) &&
+                  bench_mode(BENCH_DEFERRED_AUTO,  nodes_number, &sums[1]) &&
+                  bench_mode(BENCH_DEFERRED_BURST, nodes_number, &sums[2]);
+    if(passed && (sums[1] != sums[0] || sums[2] != sums[0])) {
+        printf("walk sums differ\n");
+        passed = false;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Compaction time is spread over the removed nodes. */
+bool bench_mode(bench_mode_t mode, size_t nodes_number, long long *sum) {
+    linked_list_t       list = {};
+    std::vector<size_t> live;
+    if(!build(&list, &live, nodes_number)) {
+        linked_list_dtor(&list);
+        return false;
+    }
+    if(mode != BENCH_EAGER &&
+       linked_list_set_deferred_remove(&list, true,
+                                       mode == BENCH_DEFERRED_AUTO ? auto_compact_percent : 0) != LINKED_LIST_SUCCESS) {
+        linked_list_dtor(&list);
+        return false;
+    }
+
+    uint64_t  random     = 0x9e3779b97f4a7c15ull;
+    size_t    burst_size = nodes_number / burst_share;
+    double    remove_ns  = 0;
+    double    compact_ns = 0;
+    double    walk_ns    = 0;
+    data_t    refill     = (data_t)nodes_number;
+    for(size_t burst = 0; burst < bursts_number; burst++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(size_t removed = 0; removed < burst_size; removed++) {
+            size_t at     = random_below(live.size(), &random);
+            data_t output = 0;
+            if(linked_list_remove(&list, live[at], &output) != LINKED_LIST_SUCCESS) {
+                linked_list_dtor(&list);
+                return false;
+            }
+            live[at] = live.back();
+            live.pop_back();
+        }
+        remove_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        if(mode == BENCH_DEFERRED_BURST) {
+            linked_list_compact(&list);
+        }
+        compact_ns += nanoseconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        linked_list_for_each(&list, [sum](size_t, data_t &data) { *sum += data; });
+        walk_ns += nanoseconds_since(start);
+
+        /* Refills go behind random live nodes, before any compaction would */
+        /* have freed the slots in deferred modes.                          */
+        while(live.size() < nodes_number) {
+            size_t after = live[random_below(live.size(), &random)];
+            if(linked_list_insert_after(&list, after, refill++) != LINKED_LIST_SUCCESS) {
+                linked_list_dtor(&list);
+                return false;
+            }
+            live.push_back(linked_list_next(&list, after));
+        }
+    }
+
+    double removed_number = (double)(burst_size * bursts_number);
+    printf("%-10s | %13.1f | %13.1f | %13.2f\n", mode_names[mode],
+           remove_ns / removed_number, compact_ns / removed_number,
+           walk_ns / (double)((nodes_number - burst_size) * bursts_number));
+
+    linked_list_dtor(&list);
+    return true;
+}
+
+/*=======================================================================================*/
+
+/* Builds the list in order and scatters it with a round of moves, so the */
+/* removes and the walk miss the cache the way a long-lived list does.    */
+bool build(linked_list_t *list, std::vector<size_t> *live, size_t nodes_number) {
+    if(linked_list_ctor(list, nodes_number + nodes_number / burst_share) != LINKED_LIST_SUCCESS) {
+        return false;
+    }
+    live->resize(nodes_number);
+    for(size_t node = 0; node < nodes_number; node++) {
+        if(linked_list_insert_before(list, 0, (data_t)node) != LINKED_LIST_SUCCESS) {
+            return false;
+        }
+        (*live)[node] = linked_list_get_tail(list);
+    }
+
+    uint64_t random = 0x2545f4914f6cdd1dull;
+    for(size_t step = 0; step < nodes_number; step++) {
+        size_t removed_at = random_below(live->size(), &random);
+        data_t removed    = 0;
+        if(linked_list_remove(list, (*live)[removed_at], &removed) != LINKED_LIST_SUCCESS) {
+            return false;
+        }
+        (*live)[removed_at] = live->back();
+
+        size_t after = (*live)[random_below(live->size() - 1, &random)];
+        if(linked_list_insert_after(list, after, removed) != LINKED_LIST_SUCCESS) {
+            return false;
+        }
+        live->back() = linked_list_next(list, after);
+    }
+    return true;
+}
+
+/*=======================================================================================*/
+
+size_t random_below(size_t bound, uint64_t *random) {
+    *random ^= *random << 13;
+    *random ^= *random >> 7;
+    *random ^= *random << 17;
+    return (size_t)(*random % bound);
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+static const size_t default_nodes_number = 1 << 22;
+static const size_t rounds_number        = 4;
+/* Arithmetic done per node, the time prefetching can hide a miss behind. */
+static const size_t heavy_work           = 64;
+
+/*=======================================================================================*/
+
+static list_error_t build_scattered (linked_list_t *list,
+                                     size_t         nodes_number);
+static double       walk_open_coded (linked_list_t *list,
+                                     size_t         work,
+                                     long long     *sum);
+static double       walk_iterator   (linked_list_t *list,
+                                     size_t         work,
+                                     long long     *sum);
+static double       walk_for_each   (linked_list_t *list,
+                                     size_t         work,
+                                     long long     *sum);
+static long long    visit           (long long      sum,
+                                     data_t         value,
+                                     size_t         work);
+static double       nanoseconds_since(std::chrono::steady_clock::time_point start);
+
+/*=======================================================================================*/
+
+int main(int argc, const char *argv[]) {
+    size_t nodes_number = default_nodes_number;
+    if(argc > 1) {
+        nodes_number = strtoull(argv[1], NULL, 10);
+    }
+
+    linked_list_t list = {};
+    if(build_scattered(&list, nodes_number) != LINKED_LIST_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    printf("scattered chain of %zu nodes, prefetch distance %d\n",
+           nodes_number, LINKED_LIST_PREFETCH_DISTANCE);
+    printf("%-12s | %12s | %12s\n", "walk", "ns/node", "heavy ns/node");
+
+    /* Sums depend on the order of the nodes, so every walk must match. */
+    double    steps      = (double)(nodes_number * rounds_number);
+    long long sums[4][2] = {};
+    printf("%-12s | %12.2f | %12.2f\n", "open coded",
+           walk_open_coded(&list, 0, &sums[0][0]) / steps, walk_open_coded(&list, heavy_work, &sums[0][1]) / steps);
+    printf("%-12s | %12.2f | %12.2f\n", "iterator",
+           walk_iterator  (&list, 0, &sums[1][0]) / steps, walk_iterator  (&list, heavy_work, &sums[1][1]) / steps);
+    printf("%-12s | %12.2f | %12.2f\n", "for_each",
+           walk_for_each  (&list, 0, &sums[2][0]) / steps, walk_for_each  (&list, heavy_work, &sums[2][1]) / steps);
+
+    linked_list_linearize(&list);
+    printf("%-12s | %12.2f | %12.2f\n", "linearized",
+           walk_for_each  (&list, 0, &sums[3][0]) / steps, walk_for_each  (&list, heavy_work, &sums[3][1]) / steps);
+
+    bool same = true;
+    for(size_t walk = 1; walk < 4; walk++) {
+        same = same && sums[walk][0] == sums[0][0] && sums[walk][1] == sums[0][1];
+    }
+    linked_list_dtor(&list);
+    return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*=======================================================================================*/
+
+/* Every node goes after a random earlier one, so neighbours in the */
+/* chain are far apart in the array.                                 */
+list_error_t build_scattered(linked_list_t *list, size_t nodes_number) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_ctor(list, nodes_number)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    for(size_t node = 0; node < nodes_number; node++) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        size_t after = node == 0 ? 0 : (size_t)(random % node) + 1;
+        if((error_code = linked_list_insert_after(list, after, (data_t)(random & 0xff))) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* What callers write today. */
+double walk_open_coded(linked_list_t *list, size_t work, long long *sum) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t round = 0; round < rounds_number; round++) {
+        for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+            *sum = visit(*sum, linked_list_data(list, node), work);
+        }
+    }
+    return nanoseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double walk_iterator(linked_list_t *list, size_t work, long long *sum) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t round = 0; round < rounds_number; round++) {
+        for(data_t &value : linked_list_range(list)) {
+            *sum = visit(*sum, value, work);
+        }
+    }
+    return nanoseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+double walk_for_each(linked_list_t *list, size_t work, long long *sum) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t round = 0; round < rounds_number; round++) {
+        linked_list_for_each(list, [sum, work](size_t, data_t &value) {
+            *sum = visit(*sum, value, work);
+        });
+    }
+    return nanoseconds_since(start);
+}
+
+/*=======================================================================================*/
+
+long long visit(long long sum, data_t value, size_t work) {
+    sum += value;
+    for(size_t step = 0; step < work; step++) {
+        sum = sum * 6364136223846793005ll + 1442695040888963407ll;
+    }
+    return sum;
+}
+
+/*=======================================================================================*/
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start).count();
+}
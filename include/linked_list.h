@@ -2,10 +2,8 @@
 #define LINKED_LIST_H
 
 #include <stdio.h>
-typedef int data_t;
-
-static const size_t poison_index = (size_t)(-1);
-static const data_t poison_data  = -1;
+#include <stdint.h>
+#include <type_traits>
 
 enum list_error_t {
     //TODO
@@ -21,25 +19,171 @@ enum list_error_t {
     LINKED_LIST_INVALID_NODE_PREV = 9,
     LINKED_LIST_LOOP_ERROR        = 10,
     LINKED_LIST_INVALID_NODE_CONNECTION = 11,
+    LINKED_LIST_INDEX_OVERFLOW          = 12,
+    LINKED_LIST_FILE_ERROR              = 13,
+    LINKED_LIST_QUEUE_FULL              = 14,
+    LINKED_LIST_QUEUE_EMPTY             = 15,
+};
+
+/* How much of the list is checked by the operations, see       */
+/* linked_list_set_verification. Nothing is compiled in at all  */
+/* with LINKED_LIST_OFF_VERIFICATION.                           */
+enum list_verify_level_t {
+    LINKED_LIST_VERIFY_OFF     = 0, /* no checks                                  */
+    LINKED_LIST_VERIFY_LOCAL   = 1, /* O(1) checks of the nodes an operation uses */
+    LINKED_LIST_VERIFY_SAMPLED = 2, /* local, whole list every verify_period ops  */
+    LINKED_LIST_VERIFY_FULL    = 3, /* whole list on entry and exit of every op   */
+};
+
+/* Where new nodes go, see linked_list_set_alloc_policy. */
+enum list_alloc_policy_t {
+    LINKED_LIST_ALLOC_LIFO    = 0, /* last freed slot, O(1)                       */
+    LINKED_LIST_ALLOC_NEAREST = 1, /* free slot closest to the neighbours, bitmap */
+};
+
+/*=======================================================================================*/
+
+/* Per-payload hooks. Specialize for a payload type to choose the value free   */
+/* slots are filled with and the way it is printed in dumps.                   */
+template <typename elem_t>
+struct list_data_traits_t {
+    static elem_t poison(void) {
+        return elem_t();
+    }
+    static int    print (char *buffer, size_t buffer_size, const elem_t &) {
+        return snprintf(buffer, buffer_size, "...");
+    }
+};
+
+template <>
+struct list_data_traits_t<int> {
+    static int poison(void) {
+        return -1;
+    }
+    static int print (char *buffer, size_t buffer_size, const int &data) {
+        return snprintf(buffer, buffer_size, "%d", data);
+    }
+};
+
+/*=======================================================================================*/
+
+/* Width of prev/next links. The largest value marks free slots and the one    */
+/* below it terminates the free list of a full array, so they are not usable. */
+template <typename index_t>
+struct list_index_traits_t {
+    static_assert(std::is_unsigned<index_t>::value, "list index type must be unsigned");
+
+    static const index_t poison       = (index_t)(-1);
+    static const size_t  max_capacity = (size_t)(index_t)(-1) - 2;
 };
 
-struct list_node_t {
-    data_t data;
-    size_t prev;
-    size_t next;
+/*=======================================================================================*/
+
+#include "linked_list_storage.h"
+#include "linked_list_order.h"
+#include "linked_list_free_bits.h"
+#include "linked_list_tombstones.h"
+#include "linked_list_stats.h"
+#include "linked_list_trace.h"
+
+/* Capacity a full list grows to. The result is clamped between the capacity */
+/* the operation needs and the limit of the index type.                      */
+typedef size_t (*list_growth_policy_t)(size_t capacity, size_t parameter);
+
+/* capacity * percent / 100, 200 doubles.        */
+size_t list_grow_geometric(size_t capacity, size_t percent);
+/* capacity + step, for tight memory budgets.     */
+size_t list_grow_additive (size_t capacity, size_t step);
+
+/* Part of the list a dump draws, see linked_list_set_dump_window. */
+static const size_t max_dump_centers = 8;
+
+struct list_dump_window_t {
+    size_t edge_nodes;
+    size_t radius;
+    size_t centers_number;
+    size_t centers[max_dump_centers];
 };
 
-struct linked_list_t {
-    list_node_t *array;
+/* Node storage is a base of the list: list_aos_storage_t keeps the        */
+/* familiar list->array of nodes, list_soa_storage_t splits it per field. */
+template <typename                             elem_t,
+          typename                             index_t   = size_t,
+          template <typename, typename> class  storage_t = list_aos_storage_t>
+struct basic_linked_list_t : storage_t<elem_t, index_t> {
+    typedef elem_t                     elem_type;
+    typedef index_t                    index_type;
+    typedef storage_t<elem_t, index_t> storage_type;
+
     size_t       capacity;
     size_t       free;
     size_t       dumps_number;
     size_t       size;
+    /* Logical position i sits in slot i + 1 and the free slots form the */
+    /* tail of the array. Kept by tail pushes and pops only.             */
+    bool         is_linear;
+    /* The first unpoisoned_free slots of the free list may still carry */
+    /* the links and payloads they had before a range was spliced off.  */
+    size_t       unpoisoned_free;
+    /* Disabled while tree is NULL, see linked_list_enable_order_index. */
+    list_order_index_t<index_t> order_index;
+    /* Under LINKED_LIST_ALLOC_NEAREST free_bits holds the free slots and */
+    /* the free list is empty, free is capacity + 1.                      */
+    list_alloc_policy_t         alloc_policy;
+    list_free_bits_t            free_bits;
+    /* Chained nodes removed in deferred mode, size counts them until they */
+    /* are compacted.                                                      */
+    list_tombstones_t           tombstones;
+    /* NULL takes memory from calloc/realloc/free (or mmap). */
+    const list_allocator_t     *allocator;
+    list_growth_policy_t        growth_policy;
+    size_t                      growth_parameter;
+    list_verify_level_t         verify_level;
+    size_t                      verify_period;
+    size_t                      verify_countdown;
 
     #ifndef LINKED_LIST_OFF_DUMP
-        FILE *general_dump_file;
+        FILE               *general_dump_file;
+        list_dump_window_t  dump_window;
+    #endif
+    #ifndef LINKED_LIST_OFF_STATS
+        list_stats_t        stats;
+    #endif
+    #ifndef LINKED_LIST_OFF_TRACE
+        /* 0 unless the list was built while a trace was open. */
+        size_t              trace_id;
     #endif
 };
+
+/*=======================================================================================*/
+
+/* Link width of the int list, e.g. -DLINKED_LIST_INDEX_TYPE=uint32_t makes */
+/* its nodes 12 bytes instead of 24.                                        */
+#ifndef LINKED_LIST_INDEX_TYPE
+    #define LINKED_LIST_INDEX_TYPE size_t
+#endif
+
+/* Verification level lists start with, e.g.                         */
+/* -DLINKED_LIST_DEFAULT_VERIFY_LEVEL=LINKED_LIST_VERIFY_FULL in tests. */
+#ifndef LINKED_LIST_DEFAULT_VERIFY_LEVEL
+    #define LINKED_LIST_DEFAULT_VERIFY_LEVEL LINKED_LIST_VERIFY_LOCAL
+#endif
+
+static const size_t default_verify_period  = 64;
+static const size_t default_growth_percent = 200;
+
+typedef int                                           data_t;
+typedef LINKED_LIST_INDEX_TYPE                        list_index_t;
+typedef basic_list_node_t  <data_t, list_index_t>     list_node_t;
+typedef basic_linked_list_t<data_t, list_index_t>     linked_list_t;
+typedef basic_linked_list_t<data_t, list_index_t,
+                            list_soa_storage_t>       soa_linked_list_t;
+
+static const list_index_t poison_index = list_index_traits_t<list_index_t>::poison;
+static const data_t       poison_data  = -1;
+
+/*=======================================================================================*/
+
 #ifdef LINKED_LIST_OFF_DUMP
     #define LINKED_LIST_DUMP(...)
 #else
@@ -51,25 +195,182 @@ struct linked_list_t {
                          #__list,             \
                          (__header));
 
-    list_error_t linked_list_dump(linked_list_t *list,
-                                  const char    *caller_file,
-                                  size_t         caller_line,
-                                  const char    *caller_function,
-                                  const char    *list_variable_name,
-                                  const char    *header);
+    template <typename list_t>
+    list_error_t linked_list_dump(list_t     *list,
+                                  const char *caller_file,
+                                  size_t      caller_line,
+                                  const char *caller_function,
+                                  const char *list_variable_name,
+                                  const char *header);
+
+    /* While the worker runs, dumps only snapshot the list and return. The */
+    /* worker writes dot files and renders everything queued with one     */
+    /* graphviz call. linked_list_dump_wait returns once the queue is      */
+    /* empty, lists wait for it before closing their log.                  */
+    list_error_t linked_list_dump_start_worker(void);
+    list_error_t linked_list_dump_stop_worker (void);
+    void         linked_list_dump_wait        (void);
 #endif
 
-list_error_t linked_list_ctor          (linked_list_t *list,
-                                        size_t         capacity);
-list_error_t linked_list_insert_after  (linked_list_t *list,
-                                        size_t         real_index,
-                                        data_t         data);
-list_error_t linked_list_insert_before (linked_list_t *list,
-                                        size_t         real_index,
-                                        data_t         data);
-list_error_t linked_list_remove        (linked_list_t *list,
-                                        size_t         real_index,
-                                        data_t        *output);
-list_error_t linked_list_dtor          (linked_list_t *list);
+template <typename list_t>
+list_error_t linked_list_ctor          (list_t                              *list,
+                                        size_t                               capacity);
+template <typename list_t>
+list_error_t linked_list_ctor          (list_t                              *list,
+                                        size_t                               capacity,
+                                        const list_allocator_t              *allocator);
+template <typename list_t>
+list_error_t linked_list_insert_after  (list_t                              *list,
+                                        size_t                               real_index,
+                                        const typename list_t::elem_type    &data);
+template <typename list_t>
+list_error_t linked_list_insert_after  (list_t                              *list,
+                                        size_t                               real_index,
+                                        typename list_t::elem_type         &&data);
+template <typename list_t>
+list_error_t linked_list_insert_before (list_t                              *list,
+                                        size_t                               real_index,
+                                        const typename list_t::elem_type    &data);
+template <typename list_t>
+list_error_t linked_list_insert_before (list_t                              *list,
+                                        size_t                               real_index,
+                                        typename list_t::elem_type         &&data);
+template <typename list_t>
+list_error_t linked_list_insert_range_after (list_t                           *list,
+                                             size_t                            real_index,
+                                             const typename list_t::elem_type *values,
+                                             size_t                            values_number);
+template <typename list_t>
+list_error_t linked_list_insert_range_before(list_t                           *list,
+                                             size_t                            real_index,
+                                             const typename list_t::elem_type *values,
+                                             size_t                            values_number);
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_after (list_t                              *list,
+                                        size_t                               real_index,
+                                        args_t                           &&...args);
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_before(list_t                              *list,
+                                        size_t                               real_index,
+                                        args_t                           &&...args);
+template <typename list_t>
+list_error_t linked_list_remove        (list_t                              *list,
+                                        size_t                               real_index,
+                                        typename list_t::elem_type          *output);
+template <typename list_t>
+list_error_t linked_list_remove_range  (list_t                              *list,
+                                        size_t                               first,
+                                        size_t                               last);
+template <typename list_t>
+list_error_t linked_list_clear         (list_t                              *list);
+template <typename list_t>
+list_error_t linked_list_poison_pending(list_t                              *list);
+template <typename list_t>
+list_error_t linked_list_dtor          (list_t                              *list);
+template <typename list_t>
+list_error_t linked_list_linearize     (list_t                              *list);
+template <typename list_t>
+list_error_t linked_list_real_index    (list_t                              *list,
+                                        size_t                               position,
+                                        size_t                              *real_index);
+template <typename list_t>
+list_error_t linked_list_position_of   (list_t                              *list,
+                                        size_t                               real_index,
+                                        size_t                              *position);
+template <typename list_t>
+list_error_t linked_list_get_at        (list_t                              *list,
+                                        size_t                               position,
+                                        typename list_t::elem_type          *output);
+template <typename list_t>
+list_error_t linked_list_insert_at     (list_t                              *list,
+                                        size_t                               position,
+                                        const typename list_t::elem_type    &data);
+template <typename list_t>
+list_error_t linked_list_insert_at     (list_t                              *list,
+                                        size_t                               position,
+                                        typename list_t::elem_type         &&data);
+template <typename list_t>
+list_error_t linked_list_remove_at     (list_t                              *list,
+                                        size_t                               position,
+                                        typename list_t::elem_type          *output);
+template <typename list_t>
+list_error_t linked_list_enable_order_index (list_t                         *list);
+template <typename list_t>
+list_error_t linked_list_disable_order_index(list_t                         *list);
+template <typename list_t>
+list_error_t linked_list_set_growth         (list_t                         *list,
+                                             list_growth_policy_t            policy,
+                                             size_t                          parameter);
+/* LINKED_LIST_ALLOC_NEAREST puts a node into the free slot closest to the */
+/* one after its prev neighbour, so churn does not scatter the chain. It    */
+/* keeps a bitmap of capacity bits, removing a range costs O(range) and    */
+/* linked_list_save writes the free list back in array order.              */
+template <typename list_t>
+list_error_t linked_list_set_alloc_policy   (list_t                         *list,
+                                             list_alloc_policy_t             policy);
+/* In deferred mode linked_list_remove only moves the payload out and marks */
+/* the node as a tombstone, iterators and for_each skip it. Tombstones are  */
+/* unlinked by linked_list_compact in one sweep over the array, which runs  */
+/* on its own once they make compact_percent percent of the size (never     */
+/* with 0) and before any operation that counts positions or scans slots.   */
+/* Turning the mode off compacts. Pools do not support it.                  */
+template <typename list_t>
+list_error_t linked_list_set_deferred_remove(list_t                         *list,
+                                             bool                            enabled,
+                                             size_t                          compact_percent);
+template <typename list_t>
+list_error_t linked_list_compact            (list_t                         *list);
+template <typename list_t>
+list_error_t linked_list_reserve            (list_t                         *list,
+                                             size_t                          capacity);
+template <typename list_t>
+list_error_t linked_list_shrink_to_fit      (list_t                         *list);
+template <typename list_t>
+list_error_t linked_list_set_verification   (list_t                         *list,
+                                             list_verify_level_t             level,
+                                             size_t                          period);
+/* Dumps draw the first and last edge_nodes nodes of the chain and radius  */
+/* neighbours of every real index in centers, the rest is summarized. All */
+/* zeros draws small lists whole and head and tail of big ones.           */
+template <typename list_t>
+list_error_t linked_list_set_dump_window    (list_t                         *list,
+                                             size_t                          edge_nodes,
+                                             const size_t                   *centers,
+                                             size_t                          centers_number,
+                                             size_t                          radius);
+/* Copies the counters and measures fragmentation with a walk over the */
+/* chain. All zeros but size and capacity with LINKED_LIST_OFF_STATS.  */
+template <typename list_t>
+list_error_t linked_list_get_stats          (list_t                         *list,
+                                             list_stats_t                   *output);
+template <typename list_t>
+list_error_t linked_list_reset_stats        (list_t                         *list);
+
+/*=======================================================================================*/
+
+#include "linked_list_impl.h"
+#include "linked_list_pool.h"
+#include "linked_list_iterator.h"
+#include "linked_list_file.h"
+#include "linked_list_concurrent.h"
+#include "linked_list_queue.h"
+#include "linked_list_parallel.h"
+#include "linked_list_scan.h"
+#include "linked_list_sort.h"
+
+/* The int lists are compiled once in linked_list.cpp. */
+LINKED_LIST_INSTANTIATE(extern, linked_list_t)
+LINKED_LIST_INSTANTIATE(extern, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_POOLED(extern, pooled_linked_list_t)
+LINKED_LIST_INSTANTIATE_FILE(extern, linked_list_t)
+LINKED_LIST_INSTANTIATE_FILE(extern, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_CONCURRENT(extern, concurrent_linked_list_t)
+LINKED_LIST_INSTANTIATE_QUEUE(extern, list_queue_t)
+LINKED_LIST_INSTANTIATE_PARALLEL(extern, linked_list_t)
+LINKED_LIST_INSTANTIATE_PARALLEL(extern, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_SCAN(extern, linked_list_t)
+LINKED_LIST_INSTANTIATE_SCAN(extern, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_SORT(extern, linked_list_t)
+LINKED_LIST_INSTANTIATE_SORT(extern, soa_linked_list_t)
 
 #endif
@@ -0,0 +1,617 @@
+#ifndef LINKED_LIST_CONCURRENT_H
+#define LINKED_LIST_CONCURRENT_H
+
+#include <atomic>
+#include <thread>
+
+/*=======================================================================================*/
+
+/* A list many threads insert into and remove from at once. Nodes live in  */
+/* segments that double in size and never move, so growth only publishes  */
+/* a new segment and nobody waits for it. Operations lock the nodes they   */
+/* relink, free slots come from a per-thread cache backed by a lock-free   */
+/* stack. Traversal and verification are only safe while no thread        */
+/* removes, e.g. between phases of a program.                              */
+static const size_t concurrent_list_cache_line    = 64;
+static const size_t concurrent_list_base_segment  = 1024;
+static const size_t concurrent_list_max_segments  = 23;
+static const size_t concurrent_list_cache_size    = 64;
+static const size_t concurrent_list_spins         = 64;
+
+template <typename elem_t>
+struct concurrent_list_node_t {
+    elem_t                data;
+    std::atomic<uint32_t> prev;
+    std::atomic<uint32_t> next;
+    std::atomic<bool>     locked;
+};
+
+template <typename elem_t>
+struct basic_concurrent_list_t {
+    static_assert(std::is_trivially_copyable<elem_t>::value,
+                  "concurrent list payload must be trivially copyable");
+
+    typedef elem_t                         elem_type;
+    typedef uint32_t                       index_type;
+    typedef concurrent_list_node_t<elem_t> node_type;
+
+    std::atomic<node_type *> segments[concurrent_list_max_segments];
+    /* Apart from each other, every thread writes them. */
+    alignas(concurrent_list_cache_line) std::atomic<size_t>   size;
+    alignas(concurrent_list_cache_line) std::atomic<size_t>   fresh;
+    /* Shared free stack, the top slot in the low half and a counter */
+    /* against ABA in the high half.                                  */
+    alignas(concurrent_list_cache_line) std::atomic<uint64_t> free_top;
+};
+
+typedef basic_concurrent_list_t<data_t> concurrent_linked_list_t;
+
+/* Owned by one thread, attach before the first operation and detach */
+/* before the thread leaves so its slots go back to the list.         */
+struct concurrent_list_cache_t {
+    uint32_t slots[concurrent_list_cache_size];
+    size_t   count;
+};
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_ctor        (clist_t                           *list,
+                                          size_t                             capacity);
+template <typename clist_t>
+list_error_t concurrent_list_attach      (clist_t                           *list,
+                                          concurrent_list_cache_t           *cache);
+template <typename clist_t>
+list_error_t concurrent_list_detach      (clist_t                           *list,
+                                          concurrent_list_cache_t           *cache);
+template <typename clist_t>
+list_error_t concurrent_list_insert_after (clist_t                          *list,
+                                           concurrent_list_cache_t          *cache,
+                                           size_t                            real_index,
+                                           const typename clist_t::elem_type &data,
+                                           size_t                           *inserted);
+template <typename clist_t>
+list_error_t concurrent_list_insert_before(clist_t                          *list,
+                                           concurrent_list_cache_t          *cache,
+                                           size_t                            real_index,
+                                           const typename clist_t::elem_type &data,
+                                           size_t                           *inserted);
+template <typename clist_t>
+list_error_t concurrent_list_remove      (clist_t                           *list,
+                                          concurrent_list_cache_t           *cache,
+                                          size_t                             real_index,
+                                          typename clist_t::elem_type       *output);
+template <typename clist_t>
+list_error_t concurrent_list_get         (clist_t                           *list,
+                                          size_t                             real_index,
+                                          typename clist_t::elem_type       *output);
+template <typename clist_t>
+list_error_t concurrent_list_verify      (clist_t                           *list);
+template <typename clist_t>
+list_error_t concurrent_list_dtor        (clist_t                           *list);
+
+template <typename clist_t>
+typename clist_t::node_type &concurrent_list_node(clist_t *list,
+                                                  size_t   real_index);
+template <typename clist_t>
+list_error_t concurrent_list_reserve_segment(clist_t *list,
+                                             size_t   segment);
+template <typename clist_t>
+list_error_t concurrent_list_find_free   (clist_t                 *list,
+                                          concurrent_list_cache_t *cache,
+                                          size_t                  *output);
+template <typename clist_t>
+void         concurrent_list_release     (clist_t                 *list,
+                                          concurrent_list_cache_t *cache,
+                                          size_t                   count);
+template <typename clist_t>
+list_error_t concurrent_list_link        (clist_t                 *list,
+                                          size_t                   created,
+                                          size_t                   left_index,
+                                          size_t                   right_index,
+                                          bool                     after);
+
+/*=======================================================================================*/
+
+/* Segment k holds base << k slots and starts after base * (2^k - 1) of them. */
+inline size_t concurrent_list_segment_of(size_t real_index, size_t *offset) {
+    size_t bucket  = real_index / concurrent_list_base_segment + 1;
+    size_t segment = (size_t)(63 - __builtin_clzll((unsigned long long)bucket));
+    *offset = real_index - concurrent_list_base_segment * (((size_t)1 << segment) - 1);
+    return segment;
+}
+
+/*=======================================================================================*/
+
+template <typename node_t>
+inline bool concurrent_list_try_lock(node_t &node) {
+    return !node.locked.exchange(true, std::memory_order_acquire);
+}
+
+/*=======================================================================================*/
+
+template <typename node_t>
+inline void concurrent_list_lock(node_t &node) {
+    for(size_t spin = 0; !concurrent_list_try_lock(node); spin++) {
+        while(node.locked.load(std::memory_order_relaxed)) {
+            if(++spin > concurrent_list_spins) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+template <typename node_t>
+inline void concurrent_list_unlock(node_t &node) {
+    node.locked.store(false, std::memory_order_release);
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_ctor(clist_t *list, size_t capacity) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    if(capacity > list_index_traits_t<uint32_t>::max_capacity) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "List capacity does not fit in index type.\r\n");
+        return LINKED_LIST_INDEX_OVERFLOW;
+    }
+
+    for(size_t segment = 0; segment < concurrent_list_max_segments; segment++) {
+        list->segments[segment].store(NULL, std::memory_order_relaxed);
+    }
+    list->size    .store(0, std::memory_order_relaxed);
+    list->fresh   .store(1, std::memory_order_relaxed);
+    list->free_top.store(list_index_traits_t<uint32_t>::poison, std::memory_order_relaxed);
+
+    size_t offset = 0;
+    size_t last   = concurrent_list_segment_of(capacity, &offset);
+    for(size_t segment = 0; segment <= last; segment++) {
+        if(concurrent_list_reserve_segment(list, segment) != LINKED_LIST_SUCCESS) {
+            concurrent_list_dtor(list);
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Error while allocating data memory.\r\n");
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+    }
+
+    typename clist_t::node_type &zero = concurrent_list_node(list, 0);
+    zero.prev.store(0, std::memory_order_relaxed);
+    zero.next.store(0, std::memory_order_relaxed);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_attach(clist_t *list, concurrent_list_cache_t *cache) {
+    C_ASSERT(list  != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(cache != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    (void)list;
+    cache->count = 0;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_detach(clist_t *list, concurrent_list_cache_t *cache) {
+    C_ASSERT(list  != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(cache != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    concurrent_list_release(list, cache, cache->count);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_insert_after(clist_t                           *list,
+                                          concurrent_list_cache_t           *cache,
+                                          size_t                             real_index,
+                                          const typename clist_t::elem_type &data,
+                                          size_t                            *inserted) {
+    C_ASSERT(list  != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(cache != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    if(real_index >= list->fresh.load(std::memory_order_acquire)) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    size_t       created    = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = concurrent_list_find_free(list, cache, &created)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+    concurrent_list_node(list, created).data = data;
+
+    if((error_code = concurrent_list_link(list, created, real_index, 0, true)) != LINKED_LIST_SUCCESS) {
+        cache->slots[cache->count++] = (uint32_t)created;
+        return error_code;
+    }
+    if(inserted != NULL) {
+        *inserted = created;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_insert_before(clist_t                           *list,
+                                           concurrent_list_cache_t           *cache,
+                                           size_t                             real_index,
+                                           const typename clist_t::elem_type &data,
+                                           size_t                            *inserted) {
+    C_ASSERT(list  != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(cache != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    if(real_index >= list->fresh.load(std::memory_order_acquire)) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    size_t       created    = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = concurrent_list_find_free(list, cache, &created)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+    concurrent_list_node(list, created).data = data;
+
+    if((error_code = concurrent_list_link(list, created, 0, real_index, false)) != LINKED_LIST_SUCCESS) {
+        cache->slots[cache->count++] = (uint32_t)created;
+        return error_code;
+    }
+    if(inserted != NULL) {
+        *inserted = created;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Links created after left_index, or before right_index when after is   */
+/* false. The created node is locked first, then left and right are only */
+/* tried, so a thread never waits while holding a node of the chain and  */
+/* no two threads can wait for each other around the ring.               */
+template <typename clist_t>
+list_error_t concurrent_list_link(clist_t *list,
+                                  size_t   created,
+                                  size_t   left_index,
+                                  size_t   right_index,
+                                  bool     after) {
+    typedef typename clist_t::node_type node_t;
+    const uint32_t poison = list_index_traits_t<uint32_t>::poison;
+
+    node_t &node = concurrent_list_node(list, created);
+    concurrent_list_lock(node);
+
+    for(size_t attempt = 0; ; attempt++) {
+        if(attempt != 0) {
+            std::this_thread::yield();
+        }
+
+        if(after) {
+            right_index = 0;
+        }
+        else {
+            left_index = concurrent_list_node(list, right_index).prev.load(std::memory_order_acquire);
+            if(left_index == poison) {
+                concurrent_list_unlock(node);
+                return LINKED_LIST_INVALID_INDEX;
+            }
+        }
+
+        node_t &left = concurrent_list_node(list, left_index);
+        if(!concurrent_list_try_lock(left)) {
+            continue;
+        }
+        if(left_index != 0 && left.prev.load(std::memory_order_relaxed) == poison) {
+            concurrent_list_unlock(left);
+            if(after) {
+                concurrent_list_unlock(node);
+                return LINKED_LIST_INVALID_INDEX;
+            }
+            continue;
+        }
+
+        if(after) {
+            right_index = left.next.load(std::memory_order_relaxed);
+        }
+        else if(left.next.load(std::memory_order_relaxed) != right_index) {
+            concurrent_list_unlock(left);
+            continue;
+        }
+
+        node_t &right = concurrent_list_node(list, right_index);
+        if(right_index != left_index && !concurrent_list_try_lock(right)) {
+            concurrent_list_unlock(left);
+            continue;
+        }
+
+        node .next.store((uint32_t)right_index, std::memory_order_relaxed);
+        node .prev.store((uint32_t)left_index,  std::memory_order_relaxed);
+        left .next.store((uint32_t)created,     std::memory_order_relaxed);
+        right.prev.store((uint32_t)created,     std::memory_order_relaxed);
+
+        if(right_index != left_index) {
+            concurrent_list_unlock(right);
+        }
+        concurrent_list_unlock(left);
+        concurrent_list_unlock(node);
+        list->size.fetch_add(1, std::memory_order_relaxed);
+        return LINKED_LIST_SUCCESS;
+    }
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_remove(clist_t                     *list,
+                                    concurrent_list_cache_t     *cache,
+                                    size_t                       real_index,
+                                    typename clist_t::elem_type *output) {
+    C_ASSERT(list   != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(cache  != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    typedef typename clist_t::node_type node_t;
+    const uint32_t poison = list_index_traits_t<uint32_t>::poison;
+
+    if(real_index == 0 || real_index >= list->fresh.load(std::memory_order_acquire)) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    node_t &node = concurrent_list_node(list, real_index);
+    for(size_t attempt = 0; ; attempt++) {
+        if(attempt != 0) {
+            std::this_thread::yield();
+        }
+
+        uint32_t left_index = node.prev.load(std::memory_order_acquire);
+        if(left_index == poison) {
+            return LINKED_LIST_INVALID_INDEX;
+        }
+
+        node_t &left = concurrent_list_node(list, left_index);
+        concurrent_list_lock(left);
+        if((left_index != 0 && left.prev.load(std::memory_order_relaxed) == poison) ||
+           left.next.load(std::memory_order_relaxed) != real_index) {
+            concurrent_list_unlock(left);
+            continue;
+        }
+        if(!concurrent_list_try_lock(node)) {
+            concurrent_list_unlock(left);
+            continue;
+        }
+
+        uint32_t right_index = node.next.load(std::memory_order_relaxed);
+        node_t  &right       = concurrent_list_node(list, right_index);
+        if(right_index != left_index && !concurrent_list_try_lock(right)) {
+            concurrent_list_unlock(node);
+            concurrent_list_unlock(left);
+            continue;
+        }
+
+        left .next.store(right_index, std::memory_order_relaxed);
+        right.prev.store(left_index,  std::memory_order_relaxed);
+        node .prev.store(poison,      std::memory_order_relaxed);
+        *output = node.data;
+
+        if(right_index != left_index) {
+            concurrent_list_unlock(right);
+        }
+        concurrent_list_unlock(node);
+        concurrent_list_unlock(left);
+        break;
+    }
+
+    list->size.fetch_sub(1, std::memory_order_relaxed);
+    if(cache->count == concurrent_list_cache_size) {
+        concurrent_list_release(list, cache, concurrent_list_cache_size / 2);
+    }
+    cache->slots[cache->count++] = (uint32_t)real_index;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_get(clist_t                     *list,
+                                 size_t                       real_index,
+                                 typename clist_t::elem_type *output) {
+    C_ASSERT(list   != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    if(real_index == 0 || real_index >= list->fresh.load(std::memory_order_acquire)) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    typename clist_t::node_type &node = concurrent_list_node(list, real_index);
+    concurrent_list_lock(node);
+    bool is_free = node.prev.load(std::memory_order_relaxed) == list_index_traits_t<uint32_t>::poison;
+    if(!is_free) {
+        *output = node.data;
+    }
+    concurrent_list_unlock(node);
+    return is_free ? LINKED_LIST_INVALID_INDEX : LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_verify(clist_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    size_t fresh  = list->fresh.load(std::memory_order_acquire);
+    size_t count  = 0;
+    size_t node   = 0;
+    do {
+        size_t next = concurrent_list_node(list, node).next.load(std::memory_order_relaxed);
+        if(next >= fresh) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Concurrent list node %zu has invalid next %zu.\r\n", node, next);
+            return LINKED_LIST_INVALID_NODE_NEXT;
+        }
+        if(concurrent_list_node(list, next).prev.load(std::memory_order_relaxed) != node) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Concurrent list nodes %zu and %zu are not connected.\r\n", node, next);
+            return LINKED_LIST_INVALID_NODE_CONNECTION;
+        }
+        if(++count > fresh) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Concurrent list is looped.\r\n");
+            return LINKED_LIST_LOOP_ERROR;
+        }
+        node = next;
+    } while(node != 0);
+
+    if(count != list->size.load(std::memory_order_relaxed) + 1) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Concurrent list size is %zu, chain has %zu nodes.\r\n",
+                     list->size.load(std::memory_order_relaxed), count - 1);
+        return LINKED_LIST_INVALID_SIZE;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+list_error_t concurrent_list_dtor(clist_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    for(size_t segment = 0; segment < concurrent_list_max_segments; segment++) {
+        free(list->segments[segment].exchange(NULL, std::memory_order_acq_rel));
+    }
+    list->size .store(0, std::memory_order_relaxed);
+    list->fresh.store(0, std::memory_order_relaxed);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename clist_t>
+typename clist_t::node_type &concurrent_list_node(clist_t *list, size_t real_index) {
+    size_t offset  = 0;
+    size_t segment = concurrent_list_segment_of(real_index, &offset);
+    return list->segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+/*=======================================================================================*/
+
+/* Threads racing for the same segment all allocate it, the first one to */
+/* publish wins and the others free their copy.                          */
+template <typename clist_t>
+list_error_t concurrent_list_reserve_segment(clist_t *list, size_t segment) {
+    typedef typename clist_t::node_type node_t;
+
+    if(list->segments[segment].load(std::memory_order_acquire) != NULL) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    node_t *block = (node_t *)calloc(concurrent_list_base_segment << segment, sizeof(node_t));
+    if(block == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    node_t *expected = NULL;
+    if(!list->segments[segment].compare_exchange_strong(expected, block, std::memory_order_acq_rel)) {
+        free(block);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Own cache first, then the shared stack, then a slot no one used yet. */
+template <typename clist_t>
+list_error_t concurrent_list_find_free(clist_t                 *list,
+                                       concurrent_list_cache_t *cache,
+                                       size_t                  *output) {
+    const uint32_t poison = list_index_traits_t<uint32_t>::poison;
+
+    if(cache->count != 0) {
+        *output = cache->slots[--cache->count];
+        return LINKED_LIST_SUCCESS;
+    }
+
+    uint64_t top = list->free_top.load(std::memory_order_acquire);
+    while((uint32_t)top != poison) {
+        uint32_t node    = (uint32_t)top;
+        uint32_t next    = concurrent_list_node(list, node).next.load(std::memory_order_relaxed);
+        uint64_t new_top = (((top >> 32) + 1) << 32) | next;
+        if(list->free_top.compare_exchange_weak(top, new_top,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+            *output = node;
+            return LINKED_LIST_SUCCESS;
+        }
+    }
+
+    size_t slot = list->fresh.load(std::memory_order_relaxed);
+    do {
+        if(slot > list_index_traits_t<uint32_t>::max_capacity) {
+            return LINKED_LIST_INDEX_OVERFLOW;
+        }
+    } while(!list->fresh.compare_exchange_weak(slot, slot + 1, std::memory_order_acq_rel));
+
+    size_t       offset     = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = concurrent_list_reserve_segment(list, concurrent_list_segment_of(slot, &offset))) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+    concurrent_list_node(list, slot).prev.store(poison, std::memory_order_relaxed);
+    *output = slot;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Chains the last count cached slots and pushes them with one CAS. */
+template <typename clist_t>
+void concurrent_list_release(clist_t *list, concurrent_list_cache_t *cache, size_t count) {
+    if(count == 0) {
+        return;
+    }
+
+    size_t first = cache->count - count;
+    for(size_t slot = first; slot + 1 < cache->count; slot++) {
+        concurrent_list_node(list, cache->slots[slot]).next.store(cache->slots[slot + 1],
+                                                                  std::memory_order_relaxed);
+    }
+
+    typename clist_t::node_type &last = concurrent_list_node(list, cache->slots[cache->count - 1]);
+    uint64_t top = list->free_top.load(std::memory_order_relaxed);
+    uint64_t new_top = 0;
+    do {
+        last.next.store((uint32_t)top, std::memory_order_relaxed);
+        new_top = (((top >> 32) + 1) << 32) | cache->slots[first];
+    } while(!list->free_top.compare_exchange_weak(top, new_top,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    cache->count = first;
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_CONCURRENT(__prefix, __clist_t)                              \
+    __prefix template list_error_t concurrent_list_ctor         <__clist_t>(__clist_t *, size_t); \
+    __prefix template list_error_t concurrent_list_attach       <__clist_t>(                 \
+        __clist_t *, concurrent_list_cache_t *);                                             \
+    __prefix template list_error_t concurrent_list_detach       <__clist_t>(                 \
+        __clist_t *, concurrent_list_cache_t *);                                             \
+    __prefix template list_error_t concurrent_list_insert_after <__clist_t>(                 \
+        __clist_t *, concurrent_list_cache_t *, size_t, const __clist_t::elem_type &, size_t *); \
+    __prefix template list_error_t concurrent_list_insert_before<__clist_t>(                 \
+        __clist_t *, concurrent_list_cache_t *, size_t, const __clist_t::elem_type &, size_t *); \
+    __prefix template list_error_t concurrent_list_remove       <__clist_t>(                 \
+        __clist_t *, concurrent_list_cache_t *, size_t, __clist_t::elem_type *);             \
+    __prefix template list_error_t concurrent_list_get          <__clist_t>(                 \
+        __clist_t *, size_t, __clist_t::elem_type *);                                        \
+    __prefix template list_error_t concurrent_list_verify       <__clist_t>(__clist_t *);    \
+    __prefix template list_error_t concurrent_list_dtor         <__clist_t>(__clist_t *);
+
+#endif
@@ -0,0 +1,412 @@
+#ifndef LINKED_LIST_FILE_H
+#define LINKED_LIST_FILE_H
+
+/*=======================================================================================*/
+
+/* Persistent lists. Links are indices, so the storage block means the same  */
+/* thing at any address and can live in a file: list_file_header_t followed */
+/* by the block is mapped shared, growth extends the file and the mapping,   */
+/* and reopening only maps it back. Nodes reach the file as they change, the */
+/* header only on linked_list_sync and linked_list_close, so the file is not */
+/* crash consistent. The header stays marked dirty from open to close, and a */
+/* dirty file is verified in full on open and refused when the nodes do not  */
+/* agree with the header (not with LINKED_LIST_OFF_VERIFICATION).            */
+/* Other blocks of the list (the order index) stay on the heap.               */
+/* Snapshots (linked_list_save/load) copy the same header fields and block    */
+/* through any file descriptor, pipes and sockets included.                   */
+#if defined(__unix__) || defined(__APPLE__)
+    #define LINKED_LIST_MAPPED_FILES
+#endif
+
+#ifdef LINKED_LIST_MAPPED_FILES
+
+static const uint64_t list_file_magic       = 0x315453494c4b4e4cULL;
+static const size_t   list_file_header_size = 4096;
+
+struct list_file_header_t {
+    uint64_t magic;
+    uint64_t elem_size;
+    uint64_t index_size;
+    uint64_t layout;
+    uint64_t capacity;
+    uint64_t free;
+    uint64_t size;
+    uint64_t unpoisoned_free;
+    uint64_t is_linear;
+    uint64_t dirty;
+};
+
+static const uint64_t list_snapshot_magic      = 0x50414e534c4b4e4cULL;
+static const uint64_t list_snapshot_version    = 1;
+static const size_t   list_snapshot_chunk_size = (size_t)1 << 23;
+
+/* Snapshot layout: this header, block_size bytes of the storage block, */
+/* then the checksum of both as one uint64_t.                           */
+struct list_snapshot_header_t {
+    uint64_t magic;
+    uint64_t version;
+    uint64_t elem_size;
+    uint64_t index_size;
+    uint64_t layout;
+    uint64_t capacity;
+    uint64_t free;
+    uint64_t size;
+    uint64_t unpoisoned_free;
+    uint64_t is_linear;
+    uint64_t block_size;
+};
+
+/* Backend state of one open file, has to outlive the list using it. */
+struct list_file_t {
+    list_allocator_t  allocator;
+    int               fd;
+    char             *mapping;
+    size_t            mapped_size;
+    bool              block_taken;
+};
+
+/*=======================================================================================*/
+
+/* Type independent part, lives in linked_list_file.cpp. */
+list_error_t list_file_map  (list_file_t *file,
+                             const char  *path,
+                             bool        *created);
+list_error_t list_file_flush(list_file_t *file);
+void         list_file_unmap(list_file_t *file);
+
+/* Whole transfers in list_snapshot_chunk_size pieces, folding the bytes */
+/* into *checksum on the way. Start a checksum with list_checksum_seed.  */
+static const uint64_t list_checksum_seed = 0xcbf29ce484222325ULL;
+
+list_error_t list_snapshot_write(int         fd,
+                                 const void *data,
+                                 size_t      size,
+                                 uint64_t   *checksum);
+list_error_t list_snapshot_read (int         fd,
+                                 void       *data,
+                                 size_t      size,
+                                 uint64_t   *checksum);
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_open (list_t      *list,
+                               list_file_t *file,
+                               const char  *path,
+                               size_t       capacity);
+template <typename list_t>
+list_error_t linked_list_sync (list_t      *list,
+                               list_file_t *file);
+template <typename list_t>
+list_error_t linked_list_close(list_t      *list,
+                               list_file_t *file);
+
+template <typename list_t>
+list_error_t linked_list_save (list_t      *list,
+                               int          fd);
+template <typename list_t>
+list_error_t linked_list_load (list_t      *list,
+                               int          fd);
+
+template <typename list_t>
+void         list_file_store_header(list_t      *list,
+                                    list_file_t *file);
+template <typename list_t>
+list_error_t list_file_write_clean (list_t      *list,
+                                    list_file_t *file);
+
+/*=======================================================================================*/
+
+/* Reopens the list kept in path, or creates it there with capacity */
+/* slots when the file is empty or does not exist.                  */
+template <typename list_t>
+list_error_t linked_list_open(list_t *list, list_file_t *file, const char *path, size_t capacity) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(file != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(path != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    static_assert(std::is_trivially_copyable<elem_t>::value,
+                  "only trivially copyable payloads can be kept in a file");
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    bool         created    = false;
+    if((error_code = list_file_map(file, path, &created)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    if(created) {
+        if((error_code = linked_list_ctor(list, capacity, &file->allocator)) != LINKED_LIST_SUCCESS) {
+            list_file_unmap(file);
+            return error_code;
+        }
+        list_file_store_header(list, file);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    list_file_header_t *header = (list_file_header_t *)file->mapping;
+    if(header->magic           != list_file_magic                            ||
+       header->elem_size       != sizeof(elem_t)                             ||
+       header->index_size      != sizeof(index_t)                            ||
+       header->layout          != list_storage_layout(list)                  ||
+       header->capacity        >  list_index_traits_t<index_t>::max_capacity ||
+       header->size            >  header->capacity                           ||
+       header->free            >  header->capacity + 1                       ||
+       header->unpoisoned_free >  header->capacity - header->size            ||
+       file->mapped_size - list_file_header_size <
+           list_storage_size(list, (size_t)header->capacity + 1)) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "File '%s' does not hold a list of this type.\r\n", path);
+        list_file_unmap(file);
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    list_storage_attach(list, file->mapping + list_file_header_size, (size_t)header->capacity + 1);
+    file->block_taken = true;
+
+    list->allocator        = &file->allocator;
+    list->capacity         = (size_t)header->capacity;
+    list->free             = (size_t)header->free;
+    list->size             = (size_t)header->size;
+    list->unpoisoned_free  = (size_t)header->unpoisoned_free;
+    list->is_linear        = header->is_linear != 0;
+    list->dumps_number     = 0;
+    list->order_index.tree = NULL;
+    list->order_index.root = 0;
+    linked_list_default_settings(list);
+
+    /* Nodes written after the last sync of a file that was not closed */
+    /* may not match the header, so all of them are checked.           */
+    #ifndef LINKED_LIST_OFF_VERIFICATION
+        error_code = header->dirty != 0 ? linked_list_verify(list) : linked_list_verify_entry(list);
+        if(error_code != LINKED_LIST_SUCCESS) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "File '%s' holds a damaged list.\r\n", path);
+            list_file_unmap(file);
+            return error_code;
+        }
+    #endif
+
+    #ifndef LINKED_LIST_OFF_DUMP
+        if((error_code = linked_list_initialize_dump(&list->general_dump_file)) != LINKED_LIST_SUCCESS) {
+            list_file_unmap(file);
+            return error_code;
+        }
+    #endif
+
+    header->dirty = 1;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Writes the header and flushes the mapping to disk. The file is marked */
+/* dirty again at once, the list stays open.                             */
+template <typename list_t>
+list_error_t linked_list_sync(list_t *list, list_file_t *file) {
+    list_error_t error_code = list_file_write_clean(list, file);
+    ((list_file_header_t *)file->mapping)->dirty = 1;
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_close(list_t *list, list_file_t *file) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_file_write_clean(list, file)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    if((error_code = linked_list_dtor(list)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+    list_file_unmap(file);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Streams header, storage block and checksum to fd. */
+template <typename list_t>
+list_error_t linked_list_save(list_t *list, int fd) {
+    LINKED_LIST_VERIFY(list);
+
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    static_assert(std::is_trivially_copyable<elem_t>::value,
+                  "only trivially copyable payloads can be saved");
+
+    linked_list_compact(list);
+    list_snapshot_header_t header = {};
+    header.magic           = list_snapshot_magic;
+    header.version         = list_snapshot_version;
+    header.elem_size       = sizeof(elem_t);
+    header.index_size      = sizeof(index_t);
+    header.layout          = list_storage_layout(list);
+    header.capacity        = list->capacity;
+    header.free            = list_free_list_head(list);
+    header.size            = list->size;
+    header.unpoisoned_free = list->unpoisoned_free;
+    header.is_linear       = list->is_linear;
+    header.block_size      = list_storage_size(list, list->capacity + 1);
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    uint64_t     checksum   = list_checksum_seed;
+    if((error_code = list_snapshot_write(fd, &header, sizeof(header), &checksum)) != LINKED_LIST_SUCCESS ||
+       (error_code = list_snapshot_write(fd,
+                                         list_storage_block(list),
+                                         (size_t)header.block_size,
+                                         &checksum)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    uint64_t trailer          = checksum;
+    uint64_t trailer_checksum = list_checksum_seed;
+    return list_snapshot_write(fd, &trailer, sizeof(trailer), &trailer_checksum);
+}
+
+/*=======================================================================================*/
+
+/* Constructs list from a snapshot. The block is read straight into the */
+/* storage of the list, nothing is rebuilt node by node.                */
+template <typename list_t>
+list_error_t linked_list_load(list_t *list, int fd) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    static_assert(std::is_trivially_copyable<elem_t>::value,
+                  "only trivially copyable payloads can be loaded");
+
+    list_error_t           error_code = LINKED_LIST_SUCCESS;
+    uint64_t               checksum   = list_checksum_seed;
+    list_snapshot_header_t header     = {};
+    if((error_code = list_snapshot_read(fd, &header, sizeof(header), &checksum)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    if(header.magic           != list_snapshot_magic                        ||
+       header.version         != list_snapshot_version                      ||
+       header.elem_size       != sizeof(elem_t)                             ||
+       header.index_size      != sizeof(index_t)                            ||
+       header.layout          != list_storage_layout(list)                  ||
+       header.capacity        >  list_index_traits_t<index_t>::max_capacity ||
+       header.size            >  header.capacity                            ||
+       header.free            >  header.capacity + 1                        ||
+       header.unpoisoned_free >  header.capacity - header.size              ||
+       header.block_size      != list_storage_size(list, (size_t)header.capacity + 1)) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Snapshot does not hold a list of this type.\r\n");
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    size_t count = (size_t)header.capacity + 1;
+    void  *block = list_block_allocate(NULL, (size_t)header.block_size);
+    if(block == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    uint64_t trailer          = 0;
+    uint64_t trailer_checksum = list_checksum_seed;
+    if((error_code = list_snapshot_read(fd, block, (size_t)header.block_size, &checksum)) != LINKED_LIST_SUCCESS ||
+       (error_code = list_snapshot_read(fd, &trailer, sizeof(trailer), &trailer_checksum)) != LINKED_LIST_SUCCESS) {
+        list_block_free(NULL, block, (size_t)header.block_size);
+        return error_code;
+    }
+    if(trailer != checksum) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Snapshot checksum mismatch.\r\n");
+        list_block_free(NULL, block, (size_t)header.block_size);
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    list_storage_attach(list, block, count);
+
+    list->allocator        = NULL;
+    list->capacity         = (size_t)header.capacity;
+    list->free             = (size_t)header.free;
+    list->size             = (size_t)header.size;
+    list->unpoisoned_free  = (size_t)header.unpoisoned_free;
+    list->is_linear        = header.is_linear != 0;
+    list->dumps_number     = 0;
+    list->order_index.tree = NULL;
+    list->order_index.root = 0;
+    linked_list_default_settings(list);
+
+    /* The checksum catches damage on the way, not a snapshot that was */
+    /* wrong when written, so the links are followed before use.       */
+    #ifndef LINKED_LIST_OFF_VERIFICATION
+        if((error_code = linked_list_verify(list)) != LINKED_LIST_SUCCESS) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Snapshot holds a damaged list.\r\n");
+            list_block_free(NULL, block, (size_t)header.block_size);
+            return error_code;
+        }
+    #endif
+
+    #ifndef LINKED_LIST_OFF_DUMP
+        if((error_code = linked_list_initialize_dump(&list->general_dump_file)) != LINKED_LIST_SUCCESS) {
+            list_block_free(NULL, block, (size_t)header.block_size);
+            return error_code;
+        }
+    #endif
+
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+void list_file_store_header(list_t *list, list_file_t *file) {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    list_file_header_t *header = (list_file_header_t *)file->mapping;
+
+    linked_list_compact(list);
+    header->magic           = list_file_magic;
+    header->elem_size       = sizeof(elem_t);
+    header->index_size      = sizeof(index_t);
+    header->layout          = list_storage_layout(list);
+    header->capacity        = list->capacity;
+    header->free            = list_free_list_head(list);
+    header->size            = list->size;
+    header->unpoisoned_free = list->unpoisoned_free;
+    header->is_linear       = list->is_linear;
+    header->dirty           = 1;
+}
+
+/*=======================================================================================*/
+
+/* Header marked clean and flushed together with the nodes. */
+template <typename list_t>
+list_error_t list_file_write_clean(list_t *list, list_file_t *file) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(file          != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(file->mapping != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    list_file_store_header(list, file);
+    ((list_file_header_t *)file->mapping)->dirty = 0;
+    return list_file_flush(file);
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_FILE(__prefix, __list_t)                                     \
+    __prefix template list_error_t linked_list_open <__list_t>(                              \
+        __list_t *, list_file_t *, const char *, size_t);                                    \
+    __prefix template list_error_t linked_list_sync <__list_t>(__list_t *, list_file_t *);   \
+    __prefix template list_error_t linked_list_close<__list_t>(__list_t *, list_file_t *);   \
+    __prefix template list_error_t linked_list_save <__list_t>(__list_t *, int);             \
+    __prefix template list_error_t linked_list_load <__list_t>(__list_t *, int);
+
+#else
+    #define LINKED_LIST_INSTANTIATE_FILE(...)
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef LINKED_LIST_FREE_BITS_H
+#define LINKED_LIST_FREE_BITS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*=======================================================================================*/
+
+/* Free slots of a list with LINKED_LIST_ALLOC_NEAREST. Bit s of level 0 is */
+/* set while slot s is free, bit w of level l + 1 while word w of level l   */
+/* is not zero, and the top level is a single word. All levels share one    */
+/* block, level l starts at words + offsets[l].                             */
+static const size_t max_free_bits_levels = 11;
+
+struct list_free_bits_t {
+    uint64_t *words;
+    size_t    bits_number;
+    size_t    levels_number;
+    size_t    offsets    [max_free_bits_levels + 1];
+};
+
+/*=======================================================================================*/
+
+/* Sizes the levels for bits_number bits, all clear. The old block is freed. */
+list_error_t list_free_bits_allocate(list_free_bits_t       *bits,
+                                     size_t                  bits_number);
+void         list_free_bits_free    (list_free_bits_t       *bits);
+/* Set bit closest to position, later ones win ties. bits_number if none. */
+size_t       list_free_bits_nearest (const list_free_bits_t *bits,
+                                     size_t                  position);
+
+template <typename list_t>
+void         list_free_bits_fill    (list_t                 *list);
+
+/*=======================================================================================*/
+
+inline bool list_free_bits_test(const list_free_bits_t *bits, size_t bit) {
+    return (bits->words[bit >> 6] >> (bit & 63) & 1) != 0;
+}
+
+/*=======================================================================================*/
+
+inline void list_free_bits_set(list_free_bits_t *bits, size_t bit) {
+    for(size_t level = 0; level < bits->levels_number; level++) {
+        uint64_t *word   = bits->words + bits->offsets[level] + (bit >> 6);
+        bool      was_on = *word != 0;
+        *word |= 1ull << (bit & 63);
+        if(was_on) {
+            return;
+        }
+        bit >>= 6;
+    }
+}
+
+/*=======================================================================================*/
+
+inline void list_free_bits_clear(list_free_bits_t *bits, size_t bit) {
+    for(size_t level = 0; level < bits->levels_number; level++) {
+        uint64_t *word = bits->words + bits->offsets[level] + (bit >> 6);
+        *word &= ~(1ull << (bit & 63));
+        if(*word != 0) {
+            return;
+        }
+        bit >>= 6;
+    }
+}
+
+/*=======================================================================================*/
+
+/* Marks the slots with poisoned prev links, the block must be sized. */
+template <typename list_t>
+void list_free_bits_fill(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    list_free_bits_t *bits = &list->free_bits;
+    memset(bits->words, 0, bits->offsets[bits->levels_number] * sizeof(uint64_t));
+    for(size_t slot = 1; slot < list->capacity + 1; slot++) {
+        if(linked_list_prev(list, slot) == list_index_traits_t<index_t>::poison) {
+            list_free_bits_set(bits, slot);
+        }
+    }
+}
+
+#endif
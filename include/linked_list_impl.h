@@ -0,0 +1,2283 @@
+#ifndef LINKED_LIST_IMPL_H
+#define LINKED_LIST_IMPL_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "custom_assert.h"
+#include "colors.h"
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_DUMP
+    static const size_t       max_file_name_length      = 64;
+    static const size_t       max_data_string_length    = 32;
+    static const size_t       max_dump_header_length    = 128;
+    /* Bigger lists are drawn as a window unless one is set, see */
+    /* linked_list_set_dump_window.                              */
+    static const size_t       max_full_dump_nodes       = 512;
+    static const size_t       default_dump_edge_nodes   = 16;
+    static const char * const zero_color                = "#bfecff";
+    static const char * const head_color                = "#cdc1ff";
+    static const char * const tail_color                = "#ffccea";
+    static const char * const elem_color                = "#fff6e3";
+    static const char * const free_color                = "#c1cfa1";
+    static const char * const skip_color                = "#e9ecef";
+
+    /*=======================================================================================*/
+
+    /* Written to the log next to every picture, whatever part of the */
+    /* list the picture shows.                                        */
+    struct list_dump_stats_t {
+        size_t chain_length; /* nodes reached from the zero element       */
+        size_t free_length;  /* slots reached from list->free             */
+        double mean_jump;    /* mean |next - node| over the chain         */
+        size_t longest_run;  /* most chain nodes in consecutive slots     */
+        size_t shown_nodes;  /* slots drawn, capacity + 1 unless windowed */
+    };
+
+    /* Collects the dot text in one large buffer instead of a stdio call */
+    /* per node and edge. Falls back to fprintf without the buffer.      */
+    struct list_dump_writer_t {
+        FILE   *file;
+        char   *buffer;
+        size_t  used;
+    };
+
+    list_error_t list_dump_writer_open (list_dump_writer_t *writer,
+                                        const char         *filename);
+    void         list_dump_write       (list_dump_writer_t *writer,
+                                        const char         *format, ...)
+                                        __attribute__((format(printf, 2, 3)));
+    list_error_t list_dump_writer_close(list_dump_writer_t *writer);
+
+    /*=======================================================================================*/
+
+    /* A dump handed to the background worker. snapshot is one allocation    */
+    /* holding a copy of the list and its storage block, render writes its    */
+    /* dot file. Payloads that can not be copied bytewise are rendered by the */
+    /* caller, then render is NULL and only graphviz and the log are left.    */
+    struct list_dump_job_t {
+        list_error_t    (*render)(void              *snapshot,
+                                  const char        *dot_filename,
+                                  list_dump_stats_t *stats);
+        void             *snapshot;
+        FILE             *general_dump_file;
+        char              dot_filename[max_file_name_length];
+        char              img_filename[max_file_name_length];
+        const char       *caller_file;
+        size_t            caller_line;
+        const char       *caller_function;
+        const char       *list_variable_name;
+        char              header[max_dump_header_length];
+        const void       *list;
+        size_t            capacity;
+        size_t            free;
+        const void       *array;
+        list_dump_stats_t stats;
+        list_dump_job_t  *next;
+    };
+
+    /*=======================================================================================*/
+
+    /* Type independent part of the dump, lives in linked_list.cpp. */
+    bool         linked_list_dump_worker_running(void);
+    list_error_t linked_list_dump_enqueue        (list_dump_job_t *job);
+    list_error_t linked_list_initialize_dump (FILE      **general_dump_file);
+    list_error_t linked_list_dump_filenames  (size_t      dumps_number,
+                                              char       *dot_filename,
+                                              char       *img_filename);
+    list_error_t linked_list_create_png_dump (FILE       *general_dump_file,
+                                              const char *img_filename,
+                                              const char *dot_filename,
+                                              const char *caller_file,
+                                              size_t      caller_line,
+                                              const char *caller_function,
+                                              const char *list_variable_name,
+                                              const char *header,
+                                              const void *list,
+                                              size_t      capacity,
+                                              size_t      free,
+                                              const void *array,
+                                              const list_dump_stats_t *stats);
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    const char  *linked_list_element_color          (list_t *list,
+                                                     size_t  node);
+    template <typename list_t>
+    list_error_t linked_list_create_dot_dump        (list_t            *list,
+                                                     const char        *filename,
+                                                     list_dump_stats_t *stats);
+    template <typename list_t>
+    list_error_t linked_list_write_node_connections (list_t             *list,
+                                                     list_dump_writer_t *writer);
+    template <typename list_t>
+    list_error_t linked_list_write_nodes            (list_t             *list,
+                                                     list_dump_writer_t *writer);
+    template <typename list_t>
+    void         linked_list_write_node             (list_t             *list,
+                                                     list_dump_writer_t *writer,
+                                                     size_t              node);
+    template <typename list_t>
+    list_error_t linked_list_write_window           (list_t             *list,
+                                                     list_dump_writer_t *writer,
+                                                     list_dump_stats_t  *stats);
+    template <typename list_t>
+    void         linked_list_mark_walk              (list_t        *list,
+                                                     unsigned char *marks,
+                                                     size_t         node,
+                                                     size_t         steps,
+                                                     bool           forward);
+    template <typename list_t>
+    void         linked_list_dump_stats             (list_t            *list,
+                                                     list_dump_stats_t *stats);
+    template <typename list_t>
+    list_error_t linked_list_dump_async             (list_t     *list,
+                                                     const char *dot_filename,
+                                                     const char *img_filename,
+                                                     const char *caller_file,
+                                                     size_t      caller_line,
+                                                     const char *caller_function,
+                                                     const char *list_variable_name,
+                                                     const char *header);
+    template <typename list_t>
+    list_t      *linked_list_snapshot               (list_t *list);
+    template <typename list_t>
+    list_error_t linked_list_render_snapshot        (void              *snapshot,
+                                                     const char        *dot_filename,
+                                                     list_dump_stats_t *stats);
+#endif
+
+/*=======================================================================================*/
+
+/* LINKED_LIST_VERIFY goes on entry of public operations and checks what the  */
+/* list level asks for, LINKED_LIST_VERIFY_NODE checks the links around one   */
+/* node in O(1) and LINKED_LIST_VERIFY_AFTER does it for the node an          */
+/* operation changed, or the whole list at LINKED_LIST_VERIFY_FULL.            */
+#ifndef LINKED_LIST_OFF_VERIFICATION
+    #define LINKED_LIST_VERIFY_CALL(__call)  {       \
+        list_error_t __error_code = (__call);        \
+        if(__error_code != LINKED_LIST_SUCCESS) {    \
+            return __error_code;                     \
+        }                                            \
+    }
+
+    #define LINKED_LIST_VERIFY(__list)                                              \
+        LINKED_LIST_VERIFY_CALL(linked_list_verify_entry((__list)))
+    #define LINKED_LIST_VERIFY_NODE(__list, __node)                                 \
+        LINKED_LIST_VERIFY_CALL(linked_list_verify_node ((__list), (__node)))
+    #define LINKED_LIST_VERIFY_AFTER(__list, __node)                                \
+        LINKED_LIST_VERIFY_CALL(linked_list_verify_after((__list), (__node)))
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_verify      (list_t *list);
+    template <typename list_t>
+    list_error_t list_free_bits_verify   (list_t *list);
+    template <typename list_t>
+    list_error_t list_tombstones_verify  (list_t *list);
+    template <typename list_t>
+    list_error_t linked_list_verify_entry(list_t *list);
+    template <typename list_t>
+    list_error_t linked_list_verify_node (list_t *list,
+                                          size_t  node);
+    template <typename list_t>
+    list_error_t linked_list_verify_links(list_t *list,
+                                          size_t  node);
+    template <typename list_t>
+    list_error_t linked_list_verify_after(list_t *list,
+                                          size_t  node);
+#else
+    #define LINKED_LIST_VERIFY(...)
+    #define LINKED_LIST_VERIFY_NODE(...)
+    #define LINKED_LIST_VERIFY_AFTER(...)
+#endif
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_find_free        (list_t *list,
+                                           size_t  prev_node,
+                                           size_t  next_node,
+                                           size_t *output);
+template <typename list_t>
+size_t       list_take_free               (list_t *list,
+                                           size_t  prev_node,
+                                           size_t  next_node);
+template <typename list_t>
+void         list_release_slot            (list_t *list,
+                                           size_t  slot);
+template <typename list_t>
+void         list_release_chain           (list_t *list,
+                                           size_t  first,
+                                           size_t  last,
+                                           size_t  count);
+template <typename list_t>
+size_t       list_free_list_head          (list_t *list);
+template <typename list_t>
+list_error_t list_remove_deferred         (list_t *list,
+                                           size_t  real_index);
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_between  (list_t    *list,
+                                           size_t     prev_node,
+                                           size_t     next_node,
+                                           args_t &&...args);
+template <typename list_t>
+size_t       linked_list_get_head         (list_t *list);
+template <typename list_t>
+size_t       linked_list_get_tail         (list_t *list);
+template <typename list_t>
+list_error_t linked_list_insert_range_between(list_t                           *list,
+                                              size_t                            prev_node,
+                                              size_t                            next_node,
+                                              const typename list_t::elem_type *values,
+                                              size_t                            values_number);
+template <typename list_t>
+list_error_t list_reallocate_memory       (list_t *list,
+                                           size_t  min_capacity);
+template <typename list_t>
+list_error_t list_resize_memory           (list_t *list,
+                                           size_t  new_capacity);
+template <typename list_t>
+list_error_t linked_list_set_default      (list_t *list,
+                                           size_t  start,
+                                           size_t  end);
+template <typename list_t>
+void         linked_list_default_settings (list_t *list);
+template <typename list_t>
+void         list_link_linear             (list_t *list);
+template <typename elem_t, typename... args_t>
+void         list_construct_data          (elem_t    *data,
+                                           args_t &&...args);
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_ctor(list_t *list, size_t capacity) {
+    return linked_list_ctor(list, capacity, NULL);
+}
+
+/*=======================================================================================*/
+
+/* The allocator has to outlive the list. */
+template <typename list_t>
+list_error_t linked_list_ctor(list_t *list, size_t capacity, const list_allocator_t *allocator) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+    C_ASSERT(allocator == NULL || (allocator->allocate != NULL && allocator->free != NULL),
+             return LINKED_LIST_NULL_PARAMETER);
+
+    typedef typename list_t::index_type index_t;
+
+    if(capacity > list_index_traits_t<index_t>::max_capacity) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "List capacity does not fit in index type.\r\n");
+        return LINKED_LIST_INDEX_OVERFLOW;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    list->allocator = allocator;
+    if(list_storage_allocate(list, capacity + 1, allocator) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while allocating data memory.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    linked_list_next(list, 0) = 0;
+    linked_list_prev(list, 0) = 0;
+    list->free                = 1;
+    list->capacity            = capacity;
+    list->size                = 0;
+    list->is_linear           = true;
+    linked_list_default_settings(list);
+
+    if((error_code = linked_list_set_default(list,
+                                             1,
+                                             capacity + 1)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    #ifndef LINKED_LIST_OFF_DUMP
+        if((error_code = linked_list_initialize_dump(&list->general_dump_file)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    #endif
+    #ifndef LINKED_LIST_OFF_TRACE
+        list->trace_id = list_trace_new_id();
+    #endif
+    LINKED_LIST_TRACE(list, LIST_TRACE_CTOR, capacity, 0, 0);
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_after(list_t                           *list,
+                                      size_t                            real_index,
+                                      const typename list_t::elem_type &data) {
+    return linked_list_emplace_after(list, real_index, data);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_after(list_t                      *list,
+                                      size_t                       real_index,
+                                      typename list_t::elem_type &&data) {
+    return linked_list_emplace_after(list, real_index, std::move(data));
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_before(list_t                           *list,
+                                       size_t                            real_index,
+                                       const typename list_t::elem_type &data) {
+    return linked_list_emplace_before(list, real_index, data);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_before(list_t                      *list,
+                                       size_t                       real_index,
+                                       typename list_t::elem_type &&data) {
+    return linked_list_emplace_before(list, real_index, std::move(data));
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_range_after(list_t                           *list,
+                                            size_t                            real_index,
+                                            const typename list_t::elem_type *values,
+                                            size_t                            values_number) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list, real_index);
+
+    list_error_t error_code = linked_list_insert_range_between(list,
+                                                               real_index,
+                                                               linked_list_next(list, real_index),
+                                                               values,
+                                                               values_number);
+    if(error_code == LINKED_LIST_SUCCESS) {
+        LINKED_LIST_TRACE_RANGE(list, LIST_TRACE_INSERT_RANGE_AFTER, real_index,
+                                linked_list_next(list, real_index), values_number);
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_range_before(list_t                           *list,
+                                             size_t                            real_index,
+                                             const typename list_t::elem_type *values,
+                                             size_t                            values_number) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list, real_index);
+
+    list_error_t error_code = linked_list_insert_range_between(list,
+                                                               linked_list_prev(list, real_index),
+                                                               real_index,
+                                                               values,
+                                                               values_number);
+    #ifndef LINKED_LIST_OFF_TRACE
+        /* The walk back to the first new node is paid only while tracing. */
+        if(error_code == LINKED_LIST_SUCCESS && list_trace_running.load(std::memory_order_relaxed)) {
+            size_t first = real_index;
+            for(size_t step = 0; step < values_number; step++) {
+                first = linked_list_prev(list, first);
+            }
+            LINKED_LIST_TRACE_RANGE(list, LIST_TRACE_INSERT_RANGE_BEFORE, real_index, first, values_number);
+        }
+    #endif
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_after(list_t *list, size_t real_index, args_t &&...args) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list, real_index);
+
+    list_error_t error_code = linked_list_emplace_between(list,
+                                                          real_index,
+                                                          linked_list_next(list, real_index),
+                                                          std::forward<args_t>(args)...);
+    if(error_code == LINKED_LIST_SUCCESS) {
+        LINKED_LIST_TRACE_INSERT(list, LIST_TRACE_INSERT_AFTER, real_index,
+                                 linked_list_next(list, real_index));
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_before(list_t *list, size_t real_index, args_t &&...args) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list, real_index);
+
+    list_error_t error_code = linked_list_emplace_between(list,
+                                                          linked_list_prev(list, real_index),
+                                                          real_index,
+                                                          std::forward<args_t>(args)...);
+    if(error_code == LINKED_LIST_SUCCESS) {
+        LINKED_LIST_TRACE_INSERT(list, LIST_TRACE_INSERT_BEFORE, real_index,
+                                 linked_list_prev(list, real_index));
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_remove(list_t                     *list,
+                                size_t                      real_index,
+                                typename list_t::elem_type *output) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index  != 0                 , return LINKED_LIST_INVALID_INDEX );
+    C_ASSERT(real_index  <  list->capacity + 1, return LINKED_LIST_INVALID_INDEX );
+    C_ASSERT(output      != NULL              , return LINKED_LIST_NULL_PARAMETER);
+    LINKED_LIST_VERIFY_NODE(list, real_index);
+
+    typedef typename list_t::index_type index_t;
+
+    if(list_tombstones_test(&list->tombstones, real_index)) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    *output                              = std::move(linked_list_data(list, real_index));
+
+    if(list->tombstones.words != NULL) {
+        return list_remove_deferred(list, real_index);
+    }
+
+    if(list->order_index.tree != NULL) {
+        list_order_remove(list, real_index);
+    }
+
+    index_t prev_node                    = linked_list_prev(list, real_index);
+    index_t next_node                    = linked_list_next(list, real_index);
+
+    linked_list_next(list, prev_node)    = next_node;
+    linked_list_prev(list, next_node)    = prev_node;
+    list_release_slot(list, real_index);
+
+    if(real_index != list->size) {
+        list->is_linear = false;
+    }
+    list->size--;
+    LINKED_LIST_STATS_ADD(list, removes, 1);
+    LINKED_LIST_TRACE    (list, LIST_TRACE_REMOVE, real_index, 0, 0);
+
+    LINKED_LIST_VERIFY_AFTER(list, prev_node);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Unlinks first..last (in logical order) and splices the whole chain onto */
+/* the free list without touching its nodes. Counting the removed nodes is */
+/* O(1) on a linear list, O(log n) with the order index and a walk over    */
+/* next links otherwise. Poisoning is left to linked_list_poison_pending,  */
+/* except under LINKED_LIST_ALLOC_NEAREST where the nodes are visited.     */
+template <typename list_t>
+list_error_t linked_list_remove_range(list_t *list, size_t first, size_t last) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(first != 0                 , return LINKED_LIST_INVALID_INDEX);
+    C_ASSERT(last  != 0                 , return LINKED_LIST_INVALID_INDEX);
+    C_ASSERT(first <  list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    C_ASSERT(last  <  list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+
+    typedef typename list_t::index_type index_t;
+
+    const index_t poison = list_index_traits_t<index_t>::poison;
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    if(linked_list_prev(list, first) == poison || linked_list_prev(list, last) == poison) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    size_t first_rank     = 0;
+    size_t removed_number = 0;
+    if(list->is_linear) {
+        if(last < first) {
+            return LINKED_LIST_INVALID_INDEX;
+        }
+        first_rank     = first - 1;
+        removed_number = last - first + 1;
+    }
+    else if(list->order_index.tree != NULL) {
+        first_rank       = list_order_rank(list, first);
+        size_t last_rank = list_order_rank(list, last);
+        if(last_rank < first_rank) {
+            return LINKED_LIST_INVALID_INDEX;
+        }
+        removed_number = last_rank - first_rank + 1;
+    }
+    else {
+        removed_number = 1;
+        for(size_t node = first; node != last; node = linked_list_next(list, node)) {
+            if(node == 0) {
+                return LINKED_LIST_INVALID_INDEX;
+            }
+            removed_number++;
+        }
+    }
+
+    if(list->order_index.tree != NULL) {
+        list_order_remove_range(list, first_rank, removed_number);
+    }
+
+    bool   keeps_linear = list->is_linear && linked_list_next(list, last) == 0;
+    size_t prev_node    = linked_list_prev(list, first);
+    size_t next_node    = linked_list_next(list, last);
+
+    linked_list_next(list, prev_node) = (index_t)next_node;
+    linked_list_prev(list, next_node) = (index_t)prev_node;
+    list_release_chain(list, first, last, removed_number);
+
+    list->size      -= removed_number;
+    list->is_linear  = keeps_linear;
+    LINKED_LIST_STATS_ADD(list, removes, removed_number);
+    LINKED_LIST_TRACE    (list, LIST_TRACE_REMOVE_RANGE, first, last, 0);
+
+    LINKED_LIST_VERIFY_AFTER(list, prev_node);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_clear(list_t *list) {
+    LINKED_LIST_VERIFY(list);
+
+    if(list->size == 0) {
+        return LINKED_LIST_SUCCESS;
+    }
+    LINKED_LIST_TRACE(list, LIST_TRACE_CLEAR, 0, 0, 0);
+
+    list_release_chain(list, linked_list_get_head(list), linked_list_get_tail(list), list->size);
+
+    linked_list_next(list, 0) = 0;
+    linked_list_prev(list, 0) = 0;
+
+    LINKED_LIST_STATS_ADD(list, removes, list->size - list->tombstones.number);
+    list->size              = 0;
+    list->order_index.root  = 0;
+    if(list->tombstones.number != 0) {
+        memset(list->tombstones.words, 0, list->tombstones.words_number * sizeof(uint64_t));
+        list->tombstones.number = 0;
+    }
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Finishes the deferred poisoning of slots released by remove_range/clear. */
+template <typename list_t>
+list_error_t linked_list_poison_pending(list_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    for(size_t node = list->free; list->unpoisoned_free != 0; list->unpoisoned_free--) {
+        linked_list_prev(list, node) = list_index_traits_t<index_t>::poison;
+        linked_list_data(list, node) = list_data_traits_t<elem_t>::poison();
+        node = linked_list_next(list, node);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_dtor(list_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+    LINKED_LIST_TRACE(list, LIST_TRACE_DTOR, 0, 0, 0);
+
+    #ifndef LINKED_LIST_OFF_DUMP
+        if(list->general_dump_file != NULL) {
+            linked_list_dump_wait();
+            fclose(list->general_dump_file);
+        }
+    #endif
+
+    list_order_free     (list);
+    list_free_bits_free (&list->free_bits);
+    list_tombstones_free(&list->tombstones);
+    list_storage_free   (list, list->capacity + 1, list->allocator);
+
+    if(memset((void *)list, 0, sizeof(list_t)) != list) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while setting list structure memory to zeros.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_linearize(list_t *list) {
+    LINKED_LIST_VERIFY(list);
+
+    typedef typename list_t::index_type index_t;
+
+    /* Recorded even when already linear: a replayed list may not be. */
+    linked_list_compact(list);
+    LINKED_LIST_TRACE  (list, LIST_TRACE_LINEARIZE, 0, 0, 0);
+    if(list->is_linear) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    const index_t poison = list_index_traits_t<index_t>::poison;
+
+    linked_list_poison_pending(list);
+
+    /* prev links are reused to hold the slot every payload has to move to. */
+    size_t position = 1;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        linked_list_prev(list, node) = (index_t)position++;
+    }
+    for(size_t node = 1; node < list->capacity + 1; node++) {
+        if(linked_list_prev(list, node) == poison) {
+            linked_list_prev(list, node) = (index_t)position++;
+        }
+    }
+
+    for(size_t node = 1; node < list->capacity + 1; node++) {
+        while(linked_list_prev(list, node) != node) {
+            size_t target = linked_list_prev(list, node);
+            std::swap(linked_list_data(list, node), linked_list_data(list, target));
+            std::swap(linked_list_prev(list, node), linked_list_prev(list, target));
+        }
+    }
+
+    list_link_linear(list);
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_real_index(list_t *list, size_t position, size_t *real_index) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index != NULL      , return LINKED_LIST_NULL_PARAMETER);
+    linked_list_compact(list);
+    C_ASSERT(position   <  list->size, return LINKED_LIST_INVALID_INDEX  );
+
+    if(list->is_linear) {
+        *real_index = position + 1;
+        return LINKED_LIST_SUCCESS;
+    }
+    if(list->order_index.tree != NULL) {
+        *real_index = list_order_select(list, position);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    size_t node = 0;
+    if(position < list->size / 2) {
+        node = linked_list_next(list, 0);
+        for(size_t step = 0; step < position; step++) {
+            node = linked_list_next(list, node);
+        }
+    }
+    else {
+        node = linked_list_prev(list, 0);
+        for(size_t step = list->size - 1; step > position; step--) {
+            node = linked_list_prev(list, node);
+        }
+    }
+
+    *real_index = node;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_position_of(list_t *list, size_t real_index, size_t *position) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(position   != NULL              , return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(real_index != 0                 , return LINKED_LIST_INVALID_INDEX  );
+    C_ASSERT(real_index <  list->capacity + 1, return LINKED_LIST_INVALID_INDEX  );
+
+    typedef typename list_t::index_type index_t;
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    if(linked_list_prev(list, real_index) == list_index_traits_t<index_t>::poison) {
+        return LINKED_LIST_INVALID_INDEX;
+    }
+
+    if(list->is_linear) {
+        *position = real_index - 1;
+        return LINKED_LIST_SUCCESS;
+    }
+    if(list->order_index.tree != NULL) {
+        *position = list_order_rank(list, real_index);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    size_t counter = 0;
+    for(size_t node = linked_list_prev(list, real_index); node != 0; node = linked_list_prev(list, node)) {
+        counter++;
+    }
+    *position = counter;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_get_at(list_t                     *list,
+                                size_t                      position,
+                                typename list_t::elem_type *output) {
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    size_t       real_index = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_real_index(list, position, &real_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    *output = linked_list_data(list, real_index);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_at(list_t                           *list,
+                                   size_t                            position,
+                                   const typename list_t::elem_type &data) {
+    linked_list_compact(list);
+    C_ASSERT(position <= list->size, return LINKED_LIST_INVALID_INDEX);
+
+    size_t       real_index = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if(position < list->size &&
+       (error_code = linked_list_real_index(list, position, &real_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    return linked_list_emplace_before(list, real_index, data);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_insert_at(list_t                      *list,
+                                   size_t                       position,
+                                   typename list_t::elem_type &&data) {
+    linked_list_compact(list);
+    C_ASSERT(position <= list->size, return LINKED_LIST_INVALID_INDEX);
+
+    size_t       real_index = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if(position < list->size &&
+       (error_code = linked_list_real_index(list, position, &real_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    return linked_list_emplace_before(list, real_index, std::move(data));
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_remove_at(list_t                     *list,
+                                   size_t                      position,
+                                   typename list_t::elem_type *output) {
+    size_t       real_index = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_real_index(list, position, &real_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    return linked_list_remove(list, real_index, output);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_enable_order_index(list_t *list) {
+    LINKED_LIST_VERIFY(list);
+
+    if(list->order_index.tree != NULL) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    if(list_order_allocate(list) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while allocating order index memory.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    list_order_build(list);
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_disable_order_index(list_t *list) {
+    LINKED_LIST_VERIFY(list);
+
+    list_order_free(list);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_set_growth(list_t *list, list_growth_policy_t policy, size_t parameter) {
+    C_ASSERT(list   != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(policy != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    list->growth_policy    = policy;
+    list->growth_parameter = parameter;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_set_alloc_policy(list_t *list, list_alloc_policy_t policy) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(policy <= LINKED_LIST_ALLOC_NEAREST, return LINKED_LIST_INVALID_INDEX);
+
+    if(policy == list->alloc_policy) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    if(policy == LINKED_LIST_ALLOC_NEAREST) {
+        if(list_free_bits_allocate(&list->free_bits, list->capacity + 1) != LINKED_LIST_SUCCESS) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Error while allocating free slot bitmap.\r\n");
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+        linked_list_poison_pending(list);
+        list_free_bits_fill(list);
+        list->free         = list->capacity + 1;
+        list->alloc_policy = policy;
+    }
+    else {
+        list->free         = list_free_list_head(list);
+        list->alloc_policy = policy;
+        list_free_bits_free(&list->free_bits);
+    }
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_set_deferred_remove(list_t *list, bool enabled, size_t compact_percent) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(compact_percent <= 100, return LINKED_LIST_INVALID_INDEX);
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    if(!enabled) {
+        if((error_code = linked_list_compact(list)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+        list_tombstones_free(&list->tombstones);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    if(list->tombstones.words == NULL &&
+       list_tombstones_resize(&list->tombstones, list->capacity + 1) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while allocating tombstone bitmap.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    list->tombstones.compact_percent = compact_percent;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Walks the bitmap word by word, so the tombstones are unlinked in slot */
+/* order and the words are read once. The links of all neighbours of a  */
+/* word are prefetched before any of its tombstones is unlinked, so      */
+/* their misses overlap.                                                 */
+template <typename list_t>
+list_error_t linked_list_compact(list_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    typedef typename list_t::index_type index_t;
+
+    list_tombstones_t *tombstones = &list->tombstones;
+    if(tombstones->number == 0) {
+        return LINKED_LIST_SUCCESS;
+    }
+    LINKED_LIST_VERIFY(list);
+
+    /* A linear list stays linear if only its last nodes were tombstones. */
+    size_t live_number  = list->size - tombstones->number;
+    bool   keeps_linear = list->is_linear;
+    for(size_t word = 0; word < tombstones->words_number; word++) {
+        uint64_t bits = tombstones->words[word];
+        tombstones->words[word] = 0;
+        for(uint64_t ahead = bits; ahead != 0; ahead &= ahead - 1) {
+            size_t slot = word * 64 + (size_t)__builtin_ctzll(ahead);
+            __builtin_prefetch(&linked_list_next(list, linked_list_prev(list, slot)), 1);
+            __builtin_prefetch(&linked_list_prev(list, linked_list_next(list, slot)), 1);
+        }
+        while(bits != 0) {
+            size_t slot = word * 64 + (size_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            if(list->order_index.tree != NULL) {
+                list_order_remove(list, slot);
+            }
+            index_t prev_node = linked_list_prev(list, slot);
+            index_t next_node = linked_list_next(list, slot);
+
+            linked_list_next(list, prev_node) = next_node;
+            linked_list_prev(list, next_node) = prev_node;
+            list_release_slot(list, slot);
+
+            if(slot <= live_number) {
+                keeps_linear = false;
+            }
+        }
+    }
+
+    list->size         = live_number;
+    list->is_linear    = keeps_linear;
+    tombstones->number = 0;
+    LINKED_LIST_STATS_ADD(list, compactions, 1);
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Grows to exactly capacity, smaller requests are ignored. */
+template <typename list_t>
+list_error_t linked_list_reserve(list_t *list, size_t capacity) {
+    LINKED_LIST_VERIFY(list);
+
+    typedef typename list_t::index_type index_t;
+
+    if(capacity <= list->capacity) {
+        return LINKED_LIST_SUCCESS;
+    }
+    if(capacity > list_index_traits_t<index_t>::max_capacity) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "List capacity does not fit in index type.\r\n");
+        return LINKED_LIST_INDEX_OVERFLOW;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_resize_memory(list, capacity)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Linearizes the list, which packs the used nodes into slots 1..size, */
+/* and releases all free slots after them. Real indices change.        */
+template <typename list_t>
+list_error_t linked_list_shrink_to_fit(list_t *list) {
+    LINKED_LIST_VERIFY(list);
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    if(list->size == list->capacity) {
+        return LINKED_LIST_SUCCESS;
+    }
+    if((error_code = linked_list_linearize(list)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+    if((error_code = list_resize_memory(list, list->size)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list->free            = list->size + 1;
+    list->unpoisoned_free = 0;
+    LINKED_LIST_TRACE(list, LIST_TRACE_SHRINK, 0, 0, 0);
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* period is the number of operations between whole list checks of */
+/* LINKED_LIST_VERIFY_SAMPLED, other levels ignore it.              */
+template <typename list_t>
+list_error_t linked_list_set_verification(list_t *list, list_verify_level_t level, size_t period) {
+    C_ASSERT(list   != NULL                    , return LINKED_LIST_NULL           );
+    C_ASSERT(level  <= LINKED_LIST_VERIFY_FULL , return LINKED_LIST_INVALID_INDEX  );
+    C_ASSERT(period != 0                       , return LINKED_LIST_INVALID_INDEX  );
+
+    list->verify_level     = level;
+    list->verify_period    = period;
+    list->verify_countdown = period;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_set_dump_window(list_t       *list,
+                                         size_t        edge_nodes,
+                                         const size_t *centers,
+                                         size_t        centers_number,
+                                         size_t        radius) {
+    C_ASSERT(list           != NULL                      , return LINKED_LIST_NULL          );
+    C_ASSERT(centers        != NULL || centers_number == 0, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(centers_number <= max_dump_centers          , return LINKED_LIST_INVALID_SIZE  );
+
+    #ifndef LINKED_LIST_OFF_DUMP
+        list->dump_window.edge_nodes     = edge_nodes;
+        list->dump_window.radius         = radius;
+        list->dump_window.centers_number = centers_number;
+        for(size_t center = 0; center < centers_number; center++) {
+            list->dump_window.centers[center] = centers[center];
+        }
+    #else
+        (void)list;
+        (void)edge_nodes;
+        (void)centers;
+        (void)centers_number;
+        (void)radius;
+    #endif
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_get_stats(list_t *list, list_stats_t *output) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    memset(output, 0, sizeof(list_stats_t));
+    #ifndef LINKED_LIST_OFF_STATS
+        *output = list->stats;
+    #endif
+    output->size     = list->size;
+    output->capacity = list->capacity;
+    /* Lists loaded from files start counting at their stored size. */
+    if(output->peak_size < output->size) {
+        output->peak_size = output->size;
+    }
+
+    if(list->is_linear || list->size < 2) {
+        return LINKED_LIST_SUCCESS;
+    }
+    size_t jumps = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        size_t next = linked_list_next(list, node);
+        if(next != 0 && next != node + 1) {
+            jumps++;
+        }
+    }
+    output->fragmentation = (double)jumps / (double)(list->size - 1);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_reset_stats(list_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    #ifndef LINKED_LIST_OFF_STATS
+        memset(&list->stats, 0, sizeof(list_stats_t));
+        list->stats.peak_size = list->size;
+    #else
+        (void)list;
+    #endif
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_DUMP
+    template <typename list_t>
+    list_error_t linked_list_dump(list_t     *list,
+                                  const char *caller_file,
+                                  size_t      caller_line,
+                                  const char *caller_function,
+                                  const char *list_variable_name,
+                                  const char *header) {
+        C_ASSERT(list               != NULL, return LINKED_LIST_NULL_PARAMETER);
+        C_ASSERT(caller_file        != NULL, return LINKED_LIST_NULL_PARAMETER);
+        C_ASSERT(caller_function    != NULL, return LINKED_LIST_NULL_PARAMETER);
+        C_ASSERT(list_variable_name != NULL, return LINKED_LIST_NULL_PARAMETER);
+        LINKED_LIST_STATS_TIME(list, dump_calls, dump_ns);
+
+        char dot_filename[max_file_name_length] = {};
+        char img_filename[max_file_name_length] = {};
+
+        linked_list_poison_pending(list);
+
+        list_error_t error_code = LINKED_LIST_SUCCESS;
+        if((error_code = linked_list_dump_filenames(list->dumps_number,
+                                                    dot_filename,
+                                                    img_filename)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+
+        if(linked_list_dump_worker_running()) {
+            return linked_list_dump_async(list,
+                                          dot_filename,
+                                          img_filename,
+                                          caller_file,
+                                          caller_line,
+                                          caller_function,
+                                          list_variable_name,
+                                          header);
+        }
+
+        list_dump_stats_t stats = {};
+        if((error_code = linked_list_create_dot_dump(list, dot_filename, &stats)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+
+        if((error_code = linked_list_create_png_dump(list->general_dump_file,
+                                                     img_filename,
+                                                     dot_filename,
+                                                     caller_file,
+                                                     caller_line,
+                                                     caller_function,
+                                                     list_variable_name,
+                                                     header,
+                                                     list,
+                                                     list->capacity,
+                                                     list->free,
+                                                     list_storage_block(list),
+                                                     &stats)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+        list->dumps_number++;
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Costs the caller one copy of the storage block, the dot file and */
+    /* graphviz are left to the worker.                                 */
+    template <typename list_t>
+    list_error_t linked_list_dump_async(list_t     *list,
+                                        const char *dot_filename,
+                                        const char *img_filename,
+                                        const char *caller_file,
+                                        size_t      caller_line,
+                                        const char *caller_function,
+                                        const char *list_variable_name,
+                                        const char *header) {
+        typedef typename list_t::elem_type elem_t;
+
+        list_dump_job_t *job = (list_dump_job_t *)calloc(1, sizeof(list_dump_job_t));
+        if(job == NULL) {
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+
+        list_error_t error_code = LINKED_LIST_SUCCESS;
+        if(std::is_trivially_copyable<elem_t>::value) {
+            if((job->snapshot = linked_list_snapshot(list)) == NULL) {
+                free(job);
+                return LINKED_LIST_MEMORY_ERROR;
+            }
+            job->render = linked_list_render_snapshot<list_t>;
+        }
+        else if((error_code = linked_list_create_dot_dump(list, dot_filename, &job->stats)) != LINKED_LIST_SUCCESS) {
+            free(job);
+            return error_code;
+        }
+
+        job->general_dump_file  = list->general_dump_file;
+        job->caller_file        = caller_file;
+        job->caller_line        = caller_line;
+        job->caller_function    = caller_function;
+        job->list_variable_name = list_variable_name;
+        job->list               = list;
+        job->capacity           = list->capacity;
+        job->free               = list->free;
+        job->array              = list_storage_block(list);
+        snprintf(job->dot_filename, sizeof(job->dot_filename), "%s", dot_filename);
+        snprintf(job->img_filename, sizeof(job->img_filename), "%s", img_filename);
+        snprintf(job->header,       sizeof(job->header),       "%s", header);
+
+        list->dumps_number++;
+        return linked_list_dump_enqueue(job);
+    }
+
+    /*=======================================================================================*/
+
+    /* The storage block follows the list copy, so free releases both. */
+    template <typename list_t>
+    list_t *linked_list_snapshot(list_t *list) {
+        size_t count        = list->capacity + 1;
+        size_t block_size   = list_storage_size(list, count);
+        size_t block_offset = (sizeof(list_t) + alignof(std::max_align_t) - 1) /
+                              alignof(std::max_align_t) * alignof(std::max_align_t);
+
+        list_t *snapshot = (list_t *)calloc(1, block_offset + block_size);
+        if(snapshot == NULL) {
+            return NULL;
+        }
+
+        void *block = (char *)snapshot + block_offset;
+        memcpy(block, list_storage_block(list), block_size);
+
+        snapshot->capacity = list->capacity;
+        snapshot->free     = list->free;
+        snapshot->size        = list->size;
+        snapshot->dump_window = list->dump_window;
+        list_storage_attach(snapshot, block, count);
+        return snapshot;
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_render_snapshot(void              *snapshot,
+                                             const char        *dot_filename,
+                                             list_dump_stats_t *stats) {
+        return linked_list_create_dot_dump((list_t *)snapshot, dot_filename, stats);
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_create_dot_dump(list_t            *list,
+                                             const char        *filename,
+                                             list_dump_stats_t *stats) {
+        list_dump_writer_t writer     = {};
+        list_error_t       error_code = LINKED_LIST_SUCCESS;
+        if((error_code = list_dump_writer_open(&writer, filename)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+
+        list_dump_write(&writer,
+                        "digraph {\r\n"
+                        "node[shape = Mrecord, style = filled];\r\n"
+                        "splines=ortho;\r\n"
+                        "rankdir = LR;\r\n");
+
+        linked_list_dump_stats(list, stats);
+
+        const list_dump_window_t *window = &list->dump_window;
+        if(window->edge_nodes != 0 || window->centers_number != 0 ||
+           list->capacity + 1 > max_full_dump_nodes) {
+            error_code = linked_list_write_window(list, &writer, stats);
+        }
+        else {
+            linked_list_write_nodes(list, &writer);
+
+            linked_list_write_node_connections(list, &writer);
+
+            list_dump_write(&writer, "FREE[fillcolor = \"#d8e2dc\"]");
+            if(list->free < list->capacity + 1) {
+                list_dump_write(&writer, "FREE -> node%zx[color = \"#9d8189\", constraint = false];\r\n", list->free);
+            }
+
+            for(size_t free = list->free; free < list->capacity; free = linked_list_next(list, free)) {
+                list_dump_write(&writer, "node%zx -> node%zx[color = \"#9d8189\", constraint = false];\r\n",
+                free, (size_t)linked_list_next(list, free));
+            }
+            stats->shown_nodes = list->capacity + 1;
+        }
+
+        list_dump_write(&writer, "}\n");
+
+        list_error_t close_error = list_dump_writer_close(&writer);
+        return error_code != LINKED_LIST_SUCCESS ? error_code : close_error;
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_write_nodes(list_t *list, list_dump_writer_t *writer) {
+        for(size_t node = 0; node < list->capacity + 1; node++) {
+            linked_list_write_node(list, writer, node);
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    void linked_list_write_node(list_t *list, list_dump_writer_t *writer, size_t node) {
+        typedef typename list_t::elem_type  elem_t;
+        typedef typename list_t::index_type index_t;
+
+        const char *color = linked_list_element_color(list, node);
+        /* Every hex digit of a size_t fits, "\\n(POISON)" is shorter. */
+        char prev[2 * sizeof(size_t) + 1] = {};
+        if(linked_list_prev(list, node) == list_index_traits_t<index_t>::poison) {
+            snprintf(prev, sizeof(prev), "\\n(POISON)");
+        }
+        else {
+            snprintf(prev, sizeof(prev), "%zx", (size_t)linked_list_prev(list, node));
+        }
+
+        char data[max_data_string_length] = {};
+        list_data_traits_t<elem_t>::print(data, max_data_string_length, linked_list_data(list, node));
+
+        list_dump_write(writer,
+                        "node%zx[label = \"%zu | {prev = %s} | {next = %zx} | {data = %s  }\", "
+                        "fillcolor = \"%s\", "
+                        "width = 1.5, height = 2];\n",
+                        node,
+                        node,
+                        prev,
+                        (size_t)linked_list_next(list, node),
+                        data,
+                        color);
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_write_node_connections(list_t             *list,
+                                                    list_dump_writer_t *writer) {
+        for(size_t edge = 0; edge < list->capacity ; edge++) {
+            list_dump_write(writer, "node%zx -> node%zx[style = invis];\r\n",
+            edge, edge + 1);
+        }
+
+
+        for(size_t node = 0, counter = 0; node != 0 || counter == 0; counter++, node = linked_list_next(list, node)) {
+            if(linked_list_prev(list, linked_list_next(list, node)) == node) {
+                list_dump_write(writer, "node%zx -> node%zx[color = \"#06d6a0\", constraint = false];\r\n",
+                                node, (size_t)linked_list_next(list, node));
+            }
+            else {
+                list_dump_write(writer, "node%zx -> node%zx[color = \"#ff006e\", constraint = false];\r\n",
+                                node, (size_t)linked_list_next(list, node));
+                list_dump_write(writer, "node%zx -> node%zx[color = \"#ff006e\", constraint = false];\r\n",
+                                (size_t)linked_list_prev(list, linked_list_next(list, node)), (size_t)linked_list_next(list, node));
+            }
+        }
+
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Draws the zero element, edge_nodes nodes from both ends of the chain   */
+    /* and radius neighbours of every center, linked in logical order. Each   */
+    /* run of nodes between them is drawn as one summary node, and so is the */
+    /* free list. The walk stops at a broken link instead of looping.         */
+    template <typename list_t>
+    list_error_t linked_list_write_window(list_t             *list,
+                                          list_dump_writer_t *writer,
+                                          list_dump_stats_t  *stats) {
+        typedef typename list_t::index_type index_t;
+
+        size_t         slots = list->capacity + 1;
+        unsigned char *marks = (unsigned char *)calloc(slots, sizeof(unsigned char));
+        if(marks == NULL) {
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+
+        list_dump_window_t window = list->dump_window;
+        if(window.edge_nodes == 0 && window.centers_number == 0) {
+            window.edge_nodes = default_dump_edge_nodes;
+        }
+
+        marks[0] = 1;
+        linked_list_mark_walk(list, marks, 0, window.edge_nodes, true);
+        linked_list_mark_walk(list, marks, 0, window.edge_nodes, false);
+        for(size_t center = 0; center < window.centers_number; center++) {
+            size_t node = window.centers[center];
+            if(node >= slots) {
+                continue;
+            }
+            marks[node] = 1;
+            if(linked_list_prev(list, node) != list_index_traits_t<index_t>::poison) {
+                linked_list_mark_walk(list, marks, node, window.radius, true);
+                linked_list_mark_walk(list, marks, node, window.radius, false);
+            }
+        }
+
+        stats->shown_nodes = 0;
+        for(size_t node = 0; node < slots; node++) {
+            if(marks[node] != 0) {
+                linked_list_write_node(list, writer, node);
+                stats->shown_nodes++;
+            }
+        }
+
+        /* Drawn nodes are marked 2 once the walk passes them. */
+        size_t shown   = 0;
+        size_t last    = 0;
+        size_t skipped = 0;
+        size_t node    = linked_list_next(list, 0);
+        for(size_t steps = 0; ; steps++) {
+            if(node >= slots || steps > slots) {
+                list_dump_write(writer,
+                                "BROKEN[label = \"chain broken after %zu\", fillcolor = \"#ff006e\"];\r\n"
+                                "node%zx -> BROKEN[color = \"#ff006e\"];\r\n",
+                                last, shown);
+                break;
+            }
+
+            if(marks[node] == 2) {
+                /* Back at a node drawn already, the chain loops. */
+                list_dump_write(writer, "node%zx -> node%zx[color = \"#ff006e\"];\r\n", shown, node);
+                break;
+            }
+
+            if(marks[node] == 0) {
+                skipped++;
+            }
+            else if(skipped != 0) {
+                list_dump_write(writer,
+                                "skip%zx[label = \"%zu nodes\", fillcolor = \"%s\"];\r\n"
+                                "node%zx -> skip%zx[color = \"#06d6a0\"];\r\n"
+                                "skip%zx -> node%zx[color = \"#06d6a0\"];\r\n",
+                                node, skipped, skip_color,
+                                shown, node,
+                                node, node);
+                skipped = 0;
+            }
+            else {
+                list_dump_write(writer, "node%zx -> node%zx[color = \"%s\"];\r\n",
+                                shown, node,
+                                linked_list_prev(list, node) == shown ? "#06d6a0" : "#ff006e");
+            }
+
+            if(node == 0) {
+                break;
+            }
+            if(marks[node] != 0) {
+                marks[node] = 2;
+                shown       = node;
+            }
+            last = node;
+            node = linked_list_next(list, node);
+        }
+
+        list_dump_write(writer,
+                        "FREE[label = \"FREE | %zu slots\", fillcolor = \"#d8e2dc\"];\r\n",
+                        stats->free_length);
+        if(list->free < slots && marks[list->free] != 0) {
+            list_dump_write(writer, "FREE -> node%zx[color = \"#9d8189\"];\r\n", list->free);
+        }
+
+        free(marks);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Marks up to steps nodes after (or before) node, stopping at the zero */
+    /* element or at a link out of range.                                   */
+    template <typename list_t>
+    void linked_list_mark_walk(list_t        *list,
+                               unsigned char *marks,
+                               size_t         node,
+                               size_t         steps,
+                               bool           forward) {
+        for(size_t step = 0; step < steps; step++) {
+            node = forward ? (size_t)linked_list_next(list, node) : (size_t)linked_list_prev(list, node);
+            if(node == 0 || node > list->capacity) {
+                return;
+            }
+            marks[node] = 1;
+        }
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    void linked_list_dump_stats(list_t *list, list_dump_stats_t *stats) {
+        size_t slots    = list->capacity + 1;
+        size_t jumps    = 0;
+        size_t run      = 0;
+        size_t previous = 0;
+
+        stats->chain_length = 0;
+        stats->longest_run  = 0;
+        for(size_t node = linked_list_next(list, 0);
+            node != 0 && node < slots && stats->chain_length < slots;
+            node = linked_list_next(list, node)) {
+            if(previous != 0) {
+                jumps += node > previous ? node - previous : previous - node;
+            }
+            run = previous != 0 && node == previous + 1 ? run + 1 : 1;
+            if(run > stats->longest_run) {
+                stats->longest_run = run;
+            }
+            stats->chain_length++;
+            previous = node;
+        }
+        stats->mean_jump = stats->chain_length > 1 ?
+                           (double)jumps / (double)(stats->chain_length - 1) : 0;
+
+        stats->free_length = 0;
+        for(size_t free = list->free;
+            free != 0 && free < slots && stats->free_length < slots;
+            free = linked_list_next(list, free)) {
+            stats->free_length++;
+        }
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    const char *linked_list_element_color(list_t *list, size_t node) {
+        typedef typename list_t::index_type index_t;
+
+        if(node == 0) {
+            return zero_color;
+        }
+        else if(node == linked_list_get_head(list)) {
+            return head_color;
+        }
+        else if(node == linked_list_get_tail(list)) {
+            return tail_color;
+        }
+        else if(linked_list_prev(list, node) != list_index_traits_t<index_t>::poison) {
+            return elem_color;
+        }
+        return free_color;
+    }
+#endif
+
+/*=======================================================================================*/
+
+/* Grows a full list and takes a slot for a node going between prev_node */
+/* and next_node.                                                        */
+template <typename list_t>
+list_error_t linked_list_find_free(list_t *list, size_t prev_node, size_t next_node, size_t *output) {
+    C_ASSERT(output      != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    if(list->size == list->capacity) {
+        if((error_code = list_reallocate_memory(list, list->capacity + 1)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+
+    *output = list_take_free(list, prev_node, next_node);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* The list must have a free slot. Nearest aims at the slot after prev_node, */
+/* or before next_node when the node becomes the head.                       */
+template <typename list_t>
+size_t list_take_free(list_t *list, size_t prev_node, size_t next_node) {
+    LINKED_LIST_STATS_ADD(list, free_pops, 1);
+
+    if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+        size_t target = prev_node != 0 ? prev_node + 1 : (next_node != 0 ? next_node - 1 : 1);
+        size_t slot   = list_free_bits_nearest(&list->free_bits, target);
+        list_free_bits_clear(&list->free_bits, slot);
+        return slot;
+    }
+
+    size_t slot = list->free;
+    list->free  = linked_list_next(list, slot);
+    if(list->unpoisoned_free != 0) {
+        list->unpoisoned_free--;
+    }
+    return slot;
+}
+
+/*=======================================================================================*/
+
+/* Poisons an unlinked slot and gives it back. */
+template <typename list_t>
+void list_release_slot(list_t *list, size_t slot) {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    linked_list_prev(list, slot) = list_index_traits_t<index_t>::poison;
+    linked_list_data(list, slot) = list_data_traits_t<elem_t>::poison();
+
+    if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+        list_free_bits_set(&list->free_bits, slot);
+        return;
+    }
+    linked_list_next(list, slot) = (index_t)list->free;
+    if(list->unpoisoned_free != 0) {
+        list->unpoisoned_free++;
+    }
+    list->free = slot;
+}
+
+/*=======================================================================================*/
+
+/* Gives back count unlinked slots chained by next links from first to */
+/* last. The free list takes the chain as it is, the bitmap needs every */
+/* slot poisoned and marked.                                            */
+template <typename list_t>
+void list_release_chain(list_t *list, size_t first, size_t last, size_t count) {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+        size_t node = first;
+        for(size_t released = 0; released < count; released++) {
+            linked_list_prev(list, node) = list_index_traits_t<index_t>::poison;
+            linked_list_data(list, node) = list_data_traits_t<elem_t>::poison();
+            list_free_bits_set(&list->free_bits, node);
+            node = linked_list_next(list, node);
+        }
+        return;
+    }
+    linked_list_next(list, last) = (index_t)list->free;
+    list->free                   = first;
+    list->unpoisoned_free       += count;
+}
+
+/*=======================================================================================*/
+
+/* Head of the free list for code that stores it. Under nearest the free */
+/* slots are chained in array order first, which only rewrites their     */
+/* next links.                                                           */
+template <typename list_t>
+size_t list_free_list_head(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    if(list->alloc_policy != LINKED_LIST_ALLOC_NEAREST) {
+        return list->free;
+    }
+    size_t head = list->capacity + 1;
+    for(size_t slot = list->capacity; slot != 0; slot--) {
+        if(list_free_bits_test(&list->free_bits, slot)) {
+            linked_list_next(list, slot) = (index_t)head;
+            head = slot;
+        }
+    }
+    return head;
+}
+
+/*=======================================================================================*/
+
+/* The payload is already moved out. The node stays chained until enough */
+/* tombstones gather for a compaction.                                    */
+template <typename list_t>
+list_error_t list_remove_deferred(list_t *list, size_t real_index) {
+    list_tombstones_t *tombstones = &list->tombstones;
+
+    list_tombstones_set(tombstones, real_index);
+    LINKED_LIST_STATS_ADD(list, removes, 1);
+    LINKED_LIST_TRACE    (list, LIST_TRACE_REMOVE, real_index, 0, 0);
+
+    if(tombstones->compact_percent != 0 &&
+       tombstones->number * 100 >= list->size * tombstones->compact_percent) {
+        return linked_list_compact(list);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename... args_t>
+list_error_t linked_list_emplace_between(list_t    *list,
+                                         size_t     prev_node,
+                                         size_t     next_node,
+                                         args_t &&...args) {
+    typedef typename list_t::index_type index_t;
+
+    size_t insertion_index = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_find_free(list, prev_node, next_node, &insertion_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list_construct_data(&linked_list_data(list, insertion_index), std::forward<args_t>(args)...);
+    linked_list_prev(list, insertion_index) = (index_t)prev_node;
+    linked_list_next(list, insertion_index) = (index_t)next_node;
+
+    linked_list_next(list, prev_node)       = (index_t)insertion_index;
+    linked_list_prev(list, next_node)       = (index_t)insertion_index;
+
+    if(list->order_index.tree != NULL) {
+        list_order_insert_after(list, prev_node, insertion_index);
+    }
+
+    if(next_node != 0 || insertion_index != list->size + 1) {
+        list->is_linear = false;
+    }
+
+    list->size++;
+    LINKED_LIST_STATS_ADD (list, inserts, 1);
+    LINKED_LIST_STATS_PEAK(list);
+
+    LINKED_LIST_VERIFY_AFTER(list, insertion_index);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Reserves once, then takes the slots off the free list as one chain. Fresh */
+/* slots come off the free list in array order, so the chain is contiguous  */
+/* unless it reuses removed slots.                                          */
+template <typename list_t>
+list_error_t linked_list_insert_range_between(list_t                           *list,
+                                              size_t                            prev_node,
+                                              size_t                            next_node,
+                                              const typename list_t::elem_type *values,
+                                              size_t                            values_number) {
+    C_ASSERT(values != NULL || values_number == 0, return LINKED_LIST_NULL_PARAMETER);
+
+    typedef typename list_t::index_type index_t;
+
+    if(values_number == 0) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if(list->capacity - list->size < values_number) {
+        if(values_number > list_index_traits_t<index_t>::max_capacity - list->size) {
+            return LINKED_LIST_INDEX_OVERFLOW;
+        }
+        if((error_code = list_reallocate_memory(list, list->size + values_number)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+    }
+
+    bool   keeps_linear = list->is_linear && next_node == 0;
+    size_t last_node    = prev_node;
+    for(size_t value = 0; value < values_number; value++) {
+        size_t insertion_index = list_take_free(list, last_node, next_node);
+
+        list_construct_data(&linked_list_data(list, insertion_index), values[value]);
+        linked_list_prev(list, insertion_index) = (index_t)last_node;
+        linked_list_next(list, last_node)       = (index_t)insertion_index;
+
+        if(list->order_index.tree != NULL) {
+            list_order_insert_after(list, last_node, insertion_index);
+        }
+        if(insertion_index != list->size + 1 + value) {
+            keeps_linear = false;
+        }
+        last_node = insertion_index;
+    }
+    linked_list_next(list, last_node) = (index_t)next_node;
+    linked_list_prev(list, next_node) = (index_t)last_node;
+
+    list->size      += values_number;
+    list->is_linear  = keeps_linear;
+    LINKED_LIST_STATS_ADD (list, inserts, values_number);
+    LINKED_LIST_STATS_PEAK(list);
+
+    LINKED_LIST_VERIFY_NODE (list, prev_node);
+    LINKED_LIST_VERIFY_AFTER(list, last_node);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Grows to at least min_capacity, or more when the growth policy asks. */
+template <typename list_t>
+list_error_t list_reallocate_memory(list_t *list, size_t min_capacity) {
+    typedef typename list_t::index_type index_t;
+
+    const size_t max_capacity = list_index_traits_t<index_t>::max_capacity;
+    if(list->capacity >= max_capacity || min_capacity > max_capacity) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "List index space is exhausted.\r\n");
+        return LINKED_LIST_INDEX_OVERFLOW;
+    }
+
+    list_growth_policy_t policy = list->growth_policy != NULL ? list->growth_policy : list_grow_geometric;
+    size_t new_capacity = policy(list->capacity, list->growth_parameter);
+    if(new_capacity > max_capacity || new_capacity < list->capacity) {
+        new_capacity = max_capacity;
+    }
+    if(new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+
+    return list_resize_memory(list, new_capacity);
+}
+
+/*=======================================================================================*/
+
+/* Moves the array to new_capacity slots. New slots are chained in array */
+/* order, which continues the free list ending at the old capacity + 1.  */
+template <typename list_t>
+list_error_t list_resize_memory(list_t *list, size_t new_capacity) {
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+
+    size_t old_count = list->capacity + 1;
+    size_t new_count = new_capacity   + 1;
+
+    LINKED_LIST_STATS_ADD(list, reallocations,     1);
+    LINKED_LIST_STATS_ADD(list, reallocated_bytes, list_storage_size(list, std::min(old_count, new_count)));
+
+    if(list_storage_resize(list, old_count, new_count, list->allocator) != LINKED_LIST_SUCCESS ||
+       list_order_resize  (list, old_count, new_count) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while reallocating list memory.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    if(new_count > old_count &&
+       (error_code = linked_list_set_default(list,
+                                             old_count,
+                                             new_count)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list->capacity = new_capacity;
+    if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+        if(list_free_bits_allocate(&list->free_bits, new_count) != LINKED_LIST_SUCCESS) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Error while reallocating free slot bitmap.\r\n");
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+        list_free_bits_fill(list);
+        list->free = new_capacity + 1;
+    }
+    if(list->tombstones.words != NULL &&
+       list_tombstones_resize(&list->tombstones, new_count) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while reallocating tombstone bitmap.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+size_t linked_list_get_head(list_t *list) {
+    return linked_list_next(list, 0);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+size_t linked_list_get_tail(list_t *list) {
+    return linked_list_prev(list, 0);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_set_default(list_t *list,
+                                     size_t  start,
+                                     size_t  end) {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    for(size_t node = start; node < end; node++) {
+        linked_list_data(list, node) = list_data_traits_t<elem_t>::poison();
+        linked_list_next(list, node) = (index_t)(node + 1);
+        linked_list_prev(list, node) = list_index_traits_t<index_t>::poison;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Chains slots 1..size in order and the rest as the free list, for */
+/* callers that have already moved the payloads into place.         */
+template <typename list_t>
+void list_link_linear(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    const index_t poison = list_index_traits_t<index_t>::poison;
+
+    for(size_t node = 1; node < list->size + 1; node++) {
+        linked_list_prev(list, node) = (index_t)(node - 1);
+        linked_list_next(list, node) = (index_t)(node + 1);
+    }
+    for(size_t node = list->size + 1; node < list->capacity + 1; node++) {
+        linked_list_prev(list, node) = poison;
+        linked_list_next(list, node) = (index_t)(node + 1);
+    }
+
+    linked_list_next(list, list->size) = 0;
+    linked_list_next(list, 0)          = (index_t)(list->size == 0 ? 0 : 1);
+    linked_list_prev(list, 0)          = (index_t)list->size;
+
+    list->free            = list->size + 1;
+    list->unpoisoned_free = 0;
+    list->is_linear       = true;
+
+    if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+        list_free_bits_fill(list);
+        list->free = list->capacity + 1;
+    }
+    if(list->order_index.tree != NULL) {
+        list_order_build(list);
+    }
+}
+
+/*=======================================================================================*/
+
+/* Growth and verification settings every new list starts with. */
+template <typename list_t>
+void linked_list_default_settings(list_t *list) {
+    list->growth_policy    = list_grow_geometric;
+    list->growth_parameter = default_growth_percent;
+    list->verify_level     = LINKED_LIST_DEFAULT_VERIFY_LEVEL;
+    list->verify_period    = default_verify_period;
+    list->verify_countdown = default_verify_period;
+    list->alloc_policy     = LINKED_LIST_ALLOC_LIFO;
+    memset(&list->free_bits,  0, sizeof(list_free_bits_t));
+    memset(&list->tombstones, 0, sizeof(list_tombstones_t));
+    #ifndef LINKED_LIST_OFF_DUMP
+        memset(&list->dump_window, 0, sizeof(list_dump_window_t));
+    #endif
+    #ifndef LINKED_LIST_OFF_STATS
+        memset(&list->stats, 0, sizeof(list_stats_t));
+    #endif
+    #ifndef LINKED_LIST_OFF_TRACE
+        list->trace_id = 0;
+    #endif
+}
+
+/*=======================================================================================*/
+
+/* Builds the payload right in the slot. Constructors that may throw go   */
+/* through a temporary so the slot never stays destroyed.                 */
+template <typename elem_t, typename... args_t>
+void list_construct_data(elem_t *data, args_t &&...args) {
+    if(std::is_nothrow_constructible<elem_t, args_t &&...>::value) {
+        data->~elem_t();
+        new (data) elem_t(std::forward<args_t>(args)...);
+    }
+    else {
+        *data = elem_t(std::forward<args_t>(args)...);
+    }
+}
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_VERIFICATION
+    /* Follows the used chain from the zero node and the free list from */
+    /* list->free, so the slots are seen in the order they are linked.  */
+    template <typename list_t>
+    list_error_t linked_list_verify(list_t *list) {
+        typedef typename list_t::index_type index_t;
+
+        if(list == NULL) {
+            return LINKED_LIST_NULL;
+        }
+        LINKED_LIST_STATS_TIME(list, verify_calls, verify_ns);
+        if(list_storage_block(list) == NULL) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        if(list->size > list->capacity) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        if(list->order_index.tree != NULL &&
+           list_order_size(list, list->order_index.root) != list->size) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+
+        list_error_t error_code = LINKED_LIST_SUCCESS;
+
+        size_t counter = 0;
+        size_t node    = 0;
+        do {
+            if((error_code = linked_list_verify_links(list, node)) != LINKED_LIST_SUCCESS) {
+                return error_code;
+            }
+            if(++counter > list->size + 1) {
+                return LINKED_LIST_LOOP_ERROR;
+            }
+            node = linked_list_next(list, node);
+        } while(node != 0);
+
+        if(counter != list->size + 1) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+
+        if(list->alloc_policy == LINKED_LIST_ALLOC_NEAREST) {
+            if((error_code = list_free_bits_verify(list)) != LINKED_LIST_SUCCESS) {
+                return error_code;
+            }
+        }
+        if((error_code = list_tombstones_verify(list)) != LINKED_LIST_SUCCESS) {
+            return error_code;
+        }
+
+        /* Slots still waiting for linked_list_poison_pending are not poisoned. */
+        counter = 0;
+        for(node = list->free; node != list->capacity + 1; node = linked_list_next(list, node)) {
+            if(node == 0 || node > list->capacity + 1) {
+                return LINKED_LIST_INVALID_NODE_NEXT;
+            }
+            if(counter >= list->unpoisoned_free &&
+               linked_list_prev(list, node) != list_index_traits_t<index_t>::poison) {
+                return LINKED_LIST_INVALID_NODE_PREV;
+            }
+            if(++counter > list->capacity - list->size) {
+                return LINKED_LIST_LOOP_ERROR;
+            }
+        }
+
+        if(list->alloc_policy != LINKED_LIST_ALLOC_NEAREST && counter != list->capacity - list->size) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+
+        if(list->is_linear) {
+            for(node = 0; node < list->size + 1; node++) {
+                if(linked_list_next(list, node) != (node == list->size ? 0 : node + 1)) {
+                    return LINKED_LIST_INVALID_NODE_NEXT;
+                }
+            }
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Under nearest the bitmap marks exactly the poisoned slots and the free */
+    /* list is empty.                                                         */
+    template <typename list_t>
+    list_error_t list_free_bits_verify(list_t *list) {
+        typedef typename list_t::index_type index_t;
+
+        if(list->free != list->capacity + 1 || list->unpoisoned_free != 0) {
+            return LINKED_LIST_INVALID_NODE_NEXT;
+        }
+        if(list->free_bits.words == NULL || list->free_bits.bits_number != list->capacity + 1 ||
+           list_free_bits_test(&list->free_bits, 0)) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        size_t free_number = 0;
+        for(size_t slot = 1; slot < list->capacity + 1; slot++) {
+            bool is_free = linked_list_prev(list, slot) == list_index_traits_t<index_t>::poison;
+            if(is_free != list_free_bits_test(&list->free_bits, slot)) {
+                return LINKED_LIST_INVALID_NODE_PREV;
+            }
+            free_number += is_free;
+        }
+        if(free_number != list->capacity - list->size) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Tombstones are counted right and are chained nodes. */
+    template <typename list_t>
+    list_error_t list_tombstones_verify(list_t *list) {
+        typedef typename list_t::index_type index_t;
+
+        const list_tombstones_t *tombstones = &list->tombstones;
+        if(tombstones->words == NULL) {
+            return tombstones->number == 0 ? LINKED_LIST_SUCCESS : LINKED_LIST_INVALID_SIZE;
+        }
+        if(tombstones->words_number * 64 < list->capacity + 1) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        size_t number = 0;
+        for(size_t word = 0; word < tombstones->words_number; word++) {
+            for(uint64_t bits = tombstones->words[word]; bits != 0; bits &= bits - 1) {
+                size_t slot = word * 64 + (size_t)__builtin_ctzll(bits);
+                if(slot == 0 || slot > list->capacity ||
+                   linked_list_prev(list, slot) == list_index_traits_t<index_t>::poison) {
+                    return LINKED_LIST_INVALID_NODE_PREV;
+                }
+                number++;
+            }
+        }
+        if(number != tombstones->number || number > list->size) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* O(1) part of linked_list_verify, sampled levels count operations here. */
+    template <typename list_t>
+    list_error_t linked_list_verify_entry(list_t *list) {
+        if(list == NULL) {
+            return LINKED_LIST_NULL;
+        }
+
+        switch(list->verify_level) {
+            case LINKED_LIST_VERIFY_OFF: {
+                return LINKED_LIST_SUCCESS;
+            }
+            case LINKED_LIST_VERIFY_FULL: {
+                return linked_list_verify(list);
+            }
+            case LINKED_LIST_VERIFY_SAMPLED: {
+                if(--list->verify_countdown == 0) {
+                    list->verify_countdown = list->verify_period;
+                    return linked_list_verify(list);
+                }
+                break;
+            }
+            case LINKED_LIST_VERIFY_LOCAL:
+            default: {
+                break;
+            }
+        }
+
+        if(list_storage_block(list) == NULL) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        if(list->size > list->capacity || list->free > list->capacity + 1) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_verify_node(list_t *list, size_t node) {
+        if(list->verify_level == LINKED_LIST_VERIFY_OFF) {
+            return LINKED_LIST_SUCCESS;
+        }
+        return linked_list_verify_links(list, node);
+    }
+
+    /*=======================================================================================*/
+
+    /* Links of node must stay inside the array and be mirrored by both */
+    /* neighbors. Free slots fail here with their poisoned prev.        */
+    template <typename list_t>
+    list_error_t linked_list_verify_links(list_t *list, size_t node) {
+        if(node > list->capacity) {
+            return LINKED_LIST_INVALID_INDEX;
+        }
+
+        size_t prev_node = linked_list_prev(list, node);
+        size_t next_node = linked_list_next(list, node);
+        if(prev_node > list->capacity) {
+            return LINKED_LIST_INVALID_NODE_PREV;
+        }
+        if(next_node > list->capacity) {
+            return LINKED_LIST_INVALID_NODE_NEXT;
+        }
+        if(linked_list_next(list, prev_node) != node ||
+           linked_list_prev(list, next_node) != node) {
+            return LINKED_LIST_INVALID_NODE_CONNECTION;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    template <typename list_t>
+    list_error_t linked_list_verify_after(list_t *list, size_t node) {
+        if(list->verify_level == LINKED_LIST_VERIFY_FULL) {
+            return linked_list_verify(list);
+        }
+        return linked_list_verify_node(list, node);
+    }
+#endif
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_DUMP
+    #define LINKED_LIST_INSTANTIATE_DUMP(__prefix, __list_t)                                 \
+        __prefix template list_error_t linked_list_dump<__list_t>(__list_t   *,              \
+                                                                  const char *,              \
+                                                                  size_t,                    \
+                                                                  const char *,              \
+                                                                  const char *,              \
+                                                                  const char *);
+#else
+    #define LINKED_LIST_INSTANTIATE_DUMP(...)
+#endif
+
+/* Explicit instantiation of the public API for one list type. */
+#define LINKED_LIST_INSTANTIATE(__prefix, __list_t)                                          \
+    __prefix template list_error_t linked_list_ctor         <__list_t>(__list_t *, size_t);  \
+    __prefix template list_error_t linked_list_ctor         <__list_t>(                      \
+        __list_t *, size_t, const list_allocator_t *);                                       \
+    __prefix template list_error_t linked_list_insert_after <__list_t>(                      \
+        __list_t *, size_t, const __list_t::elem_type &);                                    \
+    __prefix template list_error_t linked_list_insert_after <__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type &&);                                         \
+    __prefix template list_error_t linked_list_insert_before<__list_t>(                      \
+        __list_t *, size_t, const __list_t::elem_type &);                                    \
+    __prefix template list_error_t linked_list_insert_before<__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type &&);                                         \
+    __prefix template list_error_t linked_list_insert_range_after <__list_t>(                \
+        __list_t *, size_t, const __list_t::elem_type *, size_t);                            \
+    __prefix template list_error_t linked_list_insert_range_before<__list_t>(                \
+        __list_t *, size_t, const __list_t::elem_type *, size_t);                            \
+    __prefix template list_error_t linked_list_remove       <__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type *);                                          \
+    __prefix template list_error_t linked_list_remove_range <__list_t>(                      \
+        __list_t *, size_t, size_t);                                                         \
+    __prefix template list_error_t linked_list_clear        <__list_t>(__list_t *);          \
+    __prefix template list_error_t linked_list_poison_pending<__list_t>(__list_t *);         \
+    __prefix template list_error_t linked_list_dtor         <__list_t>(__list_t *);          \
+    __prefix template list_error_t linked_list_linearize    <__list_t>(__list_t *);          \
+    __prefix template list_error_t linked_list_real_index   <__list_t>(                      \
+        __list_t *, size_t, size_t *);                                                       \
+    __prefix template list_error_t linked_list_position_of  <__list_t>(                      \
+        __list_t *, size_t, size_t *);                                                       \
+    __prefix template list_error_t linked_list_get_at       <__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type *);                                          \
+    __prefix template list_error_t linked_list_insert_at    <__list_t>(                      \
+        __list_t *, size_t, const __list_t::elem_type &);                                    \
+    __prefix template list_error_t linked_list_insert_at    <__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type &&);                                         \
+    __prefix template list_error_t linked_list_remove_at    <__list_t>(                      \
+        __list_t *, size_t, __list_t::elem_type *);                                          \
+    __prefix template list_error_t linked_list_enable_order_index <__list_t>(__list_t *);    \
+    __prefix template list_error_t linked_list_disable_order_index<__list_t>(__list_t *);    \
+    __prefix template list_error_t linked_list_set_growth         <__list_t>(                \
+        __list_t *, list_growth_policy_t, size_t);                                           \
+    __prefix template list_error_t linked_list_set_alloc_policy   <__list_t>(                \
+        __list_t *, list_alloc_policy_t);                                                    \
+    __prefix template list_error_t linked_list_set_deferred_remove<__list_t>(                \
+        __list_t *, bool, size_t);                                                           \
+    __prefix template list_error_t linked_list_compact            <__list_t>(__list_t *);    \
+    __prefix template list_error_t linked_list_reserve            <__list_t>(                \
+        __list_t *, size_t);                                                                 \
+    __prefix template list_error_t linked_list_shrink_to_fit      <__list_t>(__list_t *);    \
+    __prefix template list_error_t linked_list_set_verification   <__list_t>(                \
+        __list_t *, list_verify_level_t, size_t);                                            \
+    __prefix template list_error_t linked_list_set_dump_window    <__list_t>(                \
+        __list_t *, size_t, const size_t *, size_t, size_t);                                 \
+    __prefix template list_error_t linked_list_get_stats          <__list_t>(                \
+        __list_t *, list_stats_t *);                                                         \
+    __prefix template list_error_t linked_list_reset_stats        <__list_t>(__list_t *);    \
+    LINKED_LIST_INSTANTIATE_DUMP(__prefix, __list_t)
+
+#endif
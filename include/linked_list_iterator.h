@@ -0,0 +1,227 @@
+#ifndef LINKED_LIST_ITERATOR_H
+#define LINKED_LIST_ITERATOR_H
+
+#include <stddef.h>
+#include <iterator>
+
+/*=======================================================================================*/
+
+/* How many nodes ahead of the current one traversal prefetches. The cursor */
+/* running ahead takes the cache misses while the loop body works on nodes  */
+/* already loaded. 0 turns prefetching off.                                  */
+#ifndef LINKED_LIST_PREFETCH_DISTANCE
+    #define LINKED_LIST_PREFETCH_DISTANCE 4
+#endif
+
+/*=======================================================================================*/
+
+/* Bidirectional iterator over the chain that starts and ends at sentinel,  */
+/* 0 for a list and the sentinel slot for a pooled list. Backwards when      */
+/* reverse is set. Removing the node an iterator stands on invalidates it,   */
+/* any other change to the list may leave it on a node no longer chained.   */
+/* A linear list is walked by slot number, with no dependent loads at all.  */
+/* Tombstones of deferred removal are stepped over.                         */
+template <typename list_t, bool reverse>
+struct list_iterator_t {
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename list_t::elem_type      value_type;
+    typedef ptrdiff_t                       difference_type;
+    typedef value_type                     *pointer;
+    typedef value_type                     &reference;
+
+    list_t *list;
+    size_t  node;
+    size_t  sentinel;
+    size_t  ahead;
+    size_t  linear_size;
+
+    reference        operator* () const { return linked_list_data(list, node); }
+    pointer          operator->() const { return &linked_list_data(list, node); }
+    list_iterator_t &operator++()       { list_iterator_step(this, !reverse); return *this; }
+    list_iterator_t &operator--()       { list_iterator_step(this,  reverse); return *this; }
+    list_iterator_t  operator++(int)    { list_iterator_t old = *this; ++*this; return old; }
+    list_iterator_t  operator--(int)    { list_iterator_t old = *this; --*this; return old; }
+    bool operator==(const list_iterator_t &other) const { return node == other.node; }
+    bool operator!=(const list_iterator_t &other) const { return node != other.node; }
+};
+
+template <typename list_t, bool reverse>
+struct list_range_t {
+    list_iterator_t<list_t, reverse> first;
+    list_iterator_t<list_t, reverse> last;
+
+    list_iterator_t<list_t, reverse> begin() const { return first; }
+    list_iterator_t<list_t, reverse> end  () const { return last;  }
+};
+
+/*=======================================================================================*/
+
+/* for(int &value : linked_list_range(&list)) walks head to tail, the real */
+/* index of the current node is iterator.node.                             */
+template <typename list_t>
+list_range_t<list_t, false> linked_list_range        (list_t *list);
+template <typename list_t>
+list_range_t<list_t, true>  linked_list_reverse_range(list_t *list);
+template <typename plist_t>
+list_range_t<typename plist_t::pool_type, false> pooled_list_range(plist_t *list);
+
+/* Calls function(real_index, data) for every node from head to tail. */
+template <typename list_t, typename function_t>
+list_error_t linked_list_for_each(list_t *list, function_t function);
+
+template <typename list_t, bool reverse>
+list_iterator_t<list_t, reverse> list_iterator_make(list_t *list,
+                                                    size_t  sentinel,
+                                                    size_t  node,
+                                                    size_t  linear_size);
+template <typename list_t, bool reverse>
+void list_iterator_step    (list_iterator_t<list_t, reverse> *iterator,
+                            bool                              forward);
+template <typename list_t, bool reverse>
+void list_iterator_move    (list_iterator_t<list_t, reverse> *iterator,
+                            bool                              forward);
+template <typename list_t>
+void list_prefetch_node    (list_t *list,
+                            size_t  node);
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_range_t<list_t, false> linked_list_range(list_t *list) {
+    size_t linear_size = list->is_linear ? list->size : 0;
+    size_t head        = linked_list_next(list, 0);
+
+    list_range_t<list_t, false> range = {};
+    range.first = list_iterator_make<list_t, false>(list, 0, head, linear_size);
+    range.last  = list_iterator_make<list_t, false>(list, 0, 0,    linear_size);
+    return range;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_range_t<list_t, true> linked_list_reverse_range(list_t *list) {
+    size_t linear_size = list->is_linear ? list->size : 0;
+    size_t tail        = linked_list_prev(list, 0);
+
+    list_range_t<list_t, true> range = {};
+    range.first = list_iterator_make<list_t, true>(list, 0, tail, linear_size);
+    range.last  = list_iterator_make<list_t, true>(list, 0, 0,    linear_size);
+    return range;
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_range_t<typename plist_t::pool_type, false> pooled_list_range(plist_t *list) {
+    typedef typename plist_t::pool_type pool_t;
+
+    size_t head = linked_list_next(list->pool, list->sentinel);
+
+    list_range_t<pool_t, false> range = {};
+    range.first = list_iterator_make<pool_t, false>(list->pool, list->sentinel, head,           0);
+    range.last  = list_iterator_make<pool_t, false>(list->pool, list->sentinel, list->sentinel, 0);
+    return range;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename function_t>
+list_error_t linked_list_for_each(list_t *list, function_t function) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    if(list->is_linear && list->tombstones.number == 0) {
+        for(size_t node = 1; node <= list->size; node++) {
+            function(node, linked_list_data(list, node));
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    list_range_t<list_t, false> range = linked_list_range(list);
+    for(list_iterator_t<list_t, false> iterator = range.first; iterator != range.last; ++iterator) {
+        function(iterator.node, *iterator);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Sends the ahead cursor LINKED_LIST_PREFETCH_DISTANCE nodes in front. */
+template <typename list_t, bool reverse>
+list_iterator_t<list_t, reverse> list_iterator_make(list_t *list,
+                                                    size_t  sentinel,
+                                                    size_t  node,
+                                                    size_t  linear_size) {
+    while(node != sentinel && list_tombstones_test(&list->tombstones, node)) {
+        node = reverse ? (size_t)linked_list_prev(list, node) : (size_t)linked_list_next(list, node);
+    }
+
+    list_iterator_t<list_t, reverse> iterator = {};
+    iterator.list        = list;
+    iterator.node        = node;
+    iterator.sentinel    = sentinel;
+    iterator.ahead       = node;
+    iterator.linear_size = linear_size;
+
+    #if LINKED_LIST_PREFETCH_DISTANCE > 0
+        if(linear_size == 0 && node != sentinel) {
+            for(size_t hop = 0; hop < LINKED_LIST_PREFETCH_DISTANCE && iterator.ahead != sentinel; hop++) {
+                iterator.ahead = reverse ? (size_t)linked_list_prev(list, iterator.ahead) :
+                                           (size_t)linked_list_next(list, iterator.ahead);
+                list_prefetch_node(list, iterator.ahead);
+            }
+        }
+    #endif
+    return iterator;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, bool reverse>
+void list_iterator_step(list_iterator_t<list_t, reverse> *iterator, bool forward) {
+    do {
+        list_iterator_move(iterator, forward);
+    } while(iterator->node != iterator->sentinel &&
+            list_tombstones_test(&iterator->list->tombstones, iterator->node));
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, bool reverse>
+void list_iterator_move(list_iterator_t<list_t, reverse> *iterator, bool forward) {
+    list_t *list = iterator->list;
+
+    if(iterator->linear_size != 0) {
+        size_t size = iterator->linear_size;
+        if(forward) {
+            iterator->node = iterator->node == size ? 0 : iterator->node + 1;
+        }
+        else {
+            iterator->node = iterator->node == 0 ? size : iterator->node - 1;
+        }
+        return;
+    }
+
+    iterator->node = forward ? (size_t)linked_list_next(list, iterator->node) :
+                               (size_t)linked_list_prev(list, iterator->node);
+
+    #if LINKED_LIST_PREFETCH_DISTANCE > 0
+        /* The cursor only runs ahead in the direction of the range. */
+        if(forward != reverse && iterator->ahead != iterator->sentinel) {
+            iterator->ahead = forward ? (size_t)linked_list_next(list, iterator->ahead) :
+                                        (size_t)linked_list_prev(list, iterator->ahead);
+            list_prefetch_node(list, iterator->ahead);
+        }
+    #endif
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+void list_prefetch_node(list_t *list, size_t node) {
+    __builtin_prefetch(&linked_list_next(list, node));
+    __builtin_prefetch(&linked_list_prev(list, node));
+    __builtin_prefetch(&linked_list_data(list, node));
+}
+
+#endif
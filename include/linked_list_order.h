@@ -0,0 +1,446 @@
+#ifndef LINKED_LIST_ORDER_H
+#define LINKED_LIST_ORDER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*=======================================================================================*/
+
+/* Optional order statistic index: an implicit treap over the live slots in */
+/* logical order. Slot 0 (the sentinel) is never in the tree and serves as  */
+/* the null link. Priorities are a hash of the slot, so nothing is stored.  */
+template <typename index_t>
+struct list_order_node_t {
+    index_t left;
+    index_t right;
+    index_t parent;
+    index_t size;
+};
+
+template <typename index_t>
+struct list_order_index_t {
+    list_order_node_t<index_t> *tree;
+    size_t                      root;
+};
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t list_order_allocate    (list_t *list);
+template <typename list_t>
+list_error_t list_order_resize      (list_t *list,
+                                     size_t  old_count,
+                                     size_t  new_count);
+template <typename list_t>
+void         list_order_free        (list_t *list);
+template <typename list_t>
+void         list_order_build       (list_t *list);
+template <typename list_t>
+void         list_order_insert_after(list_t *list,
+                                     size_t  prev_node,
+                                     size_t  node);
+template <typename list_t>
+void         list_order_remove      (list_t *list,
+                                     size_t  node);
+template <typename list_t>
+void         list_order_remove_range(list_t *list,
+                                     size_t  first_rank,
+                                     size_t  count);
+template <typename list_t>
+size_t       list_order_select      (list_t *list,
+                                     size_t  position);
+template <typename list_t>
+size_t       list_order_rank        (list_t *list,
+                                     size_t  node);
+
+/*=======================================================================================*/
+
+inline uint64_t list_order_priority(size_t slot) {
+    uint64_t hash = (uint64_t)slot + 0x9e3779b97f4a7c15ull;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return hash ^ (hash >> 31);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+inline size_t list_order_size(list_t *list, size_t node) {
+    return node == 0 ? 0 : list->order_index.tree[node].size;
+}
+
+template <typename list_t>
+inline void list_order_update(list_t *list, size_t node) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+    tree[node].size = (index_t)(1 + list_order_size(list, tree[node].left) +
+                                    list_order_size(list, tree[node].right));
+}
+
+/*=======================================================================================*/
+
+/* Lifts node above its parent, keeping the in-order sequence. */
+template <typename list_t>
+void list_order_rotate_up(list_t *list, size_t node) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    size_t parent      = tree[node].parent;
+    size_t grandparent = tree[parent].parent;
+
+    if(tree[parent].left == node) {
+        size_t moved = tree[node].right;
+        tree[parent].left = (index_t)moved;
+        if(moved != 0) {
+            tree[moved].parent = (index_t)parent;
+        }
+        tree[node].right = (index_t)parent;
+    }
+    else {
+        size_t moved = tree[node].left;
+        tree[parent].right = (index_t)moved;
+        if(moved != 0) {
+            tree[moved].parent = (index_t)parent;
+        }
+        tree[node].left = (index_t)parent;
+    }
+
+    tree[parent].parent = (index_t)node;
+    tree[node].parent   = (index_t)grandparent;
+
+    if(grandparent == 0) {
+        list->order_index.root = node;
+    }
+    else if(tree[grandparent].left == parent) {
+        tree[grandparent].left = (index_t)node;
+    }
+    else {
+        tree[grandparent].right = (index_t)node;
+    }
+
+    list_order_update(list, parent);
+    list_order_update(list, node);
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t list_order_allocate(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    list->order_index.tree =
+        (list_order_node_t<index_t> *)list_block_allocate(list->allocator,
+                                                          (list->capacity + 1) * sizeof(list_order_node_t<index_t>));
+    if(list->order_index.tree == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    list->order_index.root = 0;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t list_order_resize(list_t *list, size_t old_count, size_t new_count) {
+    typedef typename list_t::index_type index_t;
+
+    if(list->order_index.tree == NULL) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    list_order_node_t<index_t> *tree =
+        (list_order_node_t<index_t> *)list_block_resize(list->allocator,
+                                                        list->order_index.tree,
+                                                        old_count * sizeof(list_order_node_t<index_t>),
+                                                        new_count * sizeof(list_order_node_t<index_t>));
+    if(tree == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    if(new_count > old_count) {
+        memset(tree + old_count, 0, (new_count - old_count) * sizeof(list_order_node_t<index_t>));
+    }
+
+    list->order_index.tree = tree;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+void list_order_free(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    if(list->order_index.tree != NULL) {
+        list_block_free(list->allocator,
+                        list->order_index.tree,
+                        (list->capacity + 1) * sizeof(list_order_node_t<index_t>));
+    }
+    list->order_index.tree = NULL;
+    list->order_index.root = 0;
+}
+
+/*=======================================================================================*/
+
+/* Cartesian tree construction in logical order: the right spine is the stack */
+/* and a node's size is final once it is popped from it.                      */
+template <typename list_t>
+void list_order_build(list_t *list) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    size_t last = 0;
+    list->order_index.root = 0;
+
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        uint64_t priority = list_order_priority(node);
+        size_t   popped   = 0;
+        size_t   spine    = last;
+
+        while(spine != 0 && list_order_priority(spine) < priority) {
+            list_order_update(list, spine);
+            popped = spine;
+            spine  = tree[spine].parent;
+        }
+
+        tree[node].left   = (index_t)popped;
+        tree[node].right  = 0;
+        tree[node].parent = (index_t)spine;
+        if(popped != 0) {
+            tree[popped].parent = (index_t)node;
+        }
+        if(spine != 0) {
+            tree[spine].right = (index_t)node;
+        }
+        else {
+            list->order_index.root = node;
+        }
+        last = node;
+    }
+
+    for(size_t spine = last; spine != 0; spine = tree[spine].parent) {
+        list_order_update(list, spine);
+    }
+}
+
+/*=======================================================================================*/
+
+/* Puts node right after prev_node in logical order, prev_node 0 is the front. */
+template <typename list_t>
+void list_order_insert_after(list_t *list, size_t prev_node, size_t node) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    tree[node].left   = 0;
+    tree[node].right  = 0;
+    tree[node].size   = 1;
+
+    size_t parent = 0;
+    if(list->order_index.root == 0) {
+        list->order_index.root = node;
+    }
+    else if(prev_node == 0) {
+        parent = list->order_index.root;
+        while(tree[parent].left != 0) {
+            parent = tree[parent].left;
+        }
+        tree[parent].left = (index_t)node;
+    }
+    else if(tree[prev_node].right == 0) {
+        parent = prev_node;
+        tree[parent].right = (index_t)node;
+    }
+    else {
+        parent = tree[prev_node].right;
+        while(tree[parent].left != 0) {
+            parent = tree[parent].left;
+        }
+        tree[parent].left = (index_t)node;
+    }
+    tree[node].parent = (index_t)parent;
+
+    for(size_t ancestor = parent; ancestor != 0; ancestor = tree[ancestor].parent) {
+        tree[ancestor].size++;
+    }
+
+    uint64_t priority = list_order_priority(node);
+    while(tree[node].parent != 0 && list_order_priority(tree[node].parent) < priority) {
+        list_order_rotate_up(list, node);
+    }
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+void list_order_remove(list_t *list, size_t node) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    while(tree[node].left != 0 || tree[node].right != 0) {
+        size_t left  = tree[node].left;
+        size_t right = tree[node].right;
+        size_t child = left;
+        if(left == 0 ||
+           (right != 0 && list_order_priority(right) > list_order_priority(left))) {
+            child = right;
+        }
+        list_order_rotate_up(list, child);
+    }
+
+    size_t parent = tree[node].parent;
+    if(parent == 0) {
+        list->order_index.root = 0;
+    }
+    else if(tree[parent].left == node) {
+        tree[parent].left = 0;
+    }
+    else {
+        tree[parent].right = 0;
+    }
+
+    for(size_t ancestor = parent; ancestor != 0; ancestor = tree[ancestor].parent) {
+        tree[ancestor].size--;
+    }
+    memset(tree + node, 0, sizeof(list_order_node_t<index_t>));
+}
+
+/*=======================================================================================*/
+
+/* Splits the subtree of node into its first count nodes and the rest. */
+template <typename list_t>
+void list_order_split(list_t *list, size_t node, size_t count, size_t *left, size_t *right) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    if(node == 0) {
+        *left  = 0;
+        *right = 0;
+        return;
+    }
+
+    size_t left_size = list_order_size(list, tree[node].left);
+    if(count <= left_size) {
+        size_t split_right = 0;
+        list_order_split(list, tree[node].left, count, left, &split_right);
+        tree[node].left = (index_t)split_right;
+        if(split_right != 0) {
+            tree[split_right].parent = (index_t)node;
+        }
+        *right = node;
+    }
+    else {
+        size_t split_left = 0;
+        list_order_split(list, tree[node].right, count - left_size - 1, &split_left, right);
+        tree[node].right = (index_t)split_left;
+        if(split_left != 0) {
+            tree[split_left].parent = (index_t)node;
+        }
+        *left = node;
+    }
+    list_order_update(list, node);
+}
+
+/*=======================================================================================*/
+
+/* Joins two subtrees, every node of first preceding every node of second. */
+template <typename list_t>
+size_t list_order_merge(list_t *list, size_t first, size_t second) {
+    typedef typename list_t::index_type index_t;
+
+    list_order_node_t<index_t> *tree = list->order_index.tree;
+
+    if(first == 0) {
+        return second;
+    }
+    if(second == 0) {
+        return first;
+    }
+
+    if(list_order_priority(first) > list_order_priority(second)) {
+        size_t merged = list_order_merge(list, tree[first].right, second);
+        tree[first].right   = (index_t)merged;
+        tree[merged].parent = (index_t)first;
+        list_order_update(list, first);
+        return first;
+    }
+
+    size_t merged = list_order_merge(list, first, tree[second].left);
+    tree[second].left   = (index_t)merged;
+    tree[merged].parent = (index_t)second;
+    list_order_update(list, second);
+    return second;
+}
+
+/*=======================================================================================*/
+
+/* Cuts count consecutive positions out of the tree in O(log n), the cut */
+/* nodes keep stale links until their slots are inserted again.          */
+template <typename list_t>
+void list_order_remove_range(list_t *list, size_t first_rank, size_t count) {
+    size_t before = 0;
+    size_t middle = 0;
+    size_t after  = 0;
+
+    list_order_split(list, list->order_index.root, first_rank, &before, &after);
+    list_order_split(list, after,                  count,      &middle, &after);
+
+    if(before != 0) {
+        list->order_index.tree[before].parent = 0;
+    }
+    if(after != 0) {
+        list->order_index.tree[after].parent = 0;
+    }
+
+    size_t root = list_order_merge(list, before, after);
+    if(root != 0) {
+        list->order_index.tree[root].parent = 0;
+    }
+    list->order_index.root = root;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+size_t list_order_select(list_t *list, size_t position) {
+    list_order_node_t<typename list_t::index_type> *tree = list->order_index.tree;
+
+    size_t node = list->order_index.root;
+    while(node != 0) {
+        size_t left_size = list_order_size(list, tree[node].left);
+        if(position < left_size) {
+            node = tree[node].left;
+        }
+        else if(position == left_size) {
+            return node;
+        }
+        else {
+            position -= left_size + 1;
+            node      = tree[node].right;
+        }
+    }
+    return 0;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+size_t list_order_rank(list_t *list, size_t node) {
+    list_order_node_t<typename list_t::index_type> *tree = list->order_index.tree;
+
+    size_t rank = list_order_size(list, tree[node].left);
+    for(size_t child = node, parent = tree[node].parent; parent != 0;
+        child = parent, parent = tree[parent].parent) {
+        if(tree[parent].right == child) {
+            rank += list_order_size(list, tree[parent].left) + 1;
+        }
+    }
+    return rank;
+}
+
+#endif
@@ -0,0 +1,322 @@
+#ifndef LINKED_LIST_PARALLEL_H
+#define LINKED_LIST_PARALLEL_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*=======================================================================================*/
+
+/* Order-dependent passes split across threads by sublist ranking: random */
+/* live nodes are picked as splitters, every thread walks from its        */
+/* splitters to the next one, and a short serial pass over the sublists   */
+/* turns their lengths into logical offsets. The list must not change     */
+/* while a parallel pass runs. threads_number 0 uses every core.          */
+static const size_t list_splitters_per_thread = 32;
+
+struct list_sublists_t {
+    size_t    number;
+    size_t   *heads;
+    size_t   *lengths;
+    size_t   *offsets;
+    size_t   *successors;
+    uint32_t *splitter_of;
+};
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_rank            (list_t                     *list,
+                                          size_t                     *positions,
+                                          size_t                      threads_number);
+template <typename list_t>
+list_error_t linked_list_parallel_export (list_t                     *list,
+                                          typename list_t::elem_type *output,
+                                          size_t                      threads_number);
+/* function(position, real_index, data) once per node, on any thread. */
+template <typename list_t, typename function_t>
+list_error_t linked_list_parallel_for_each(list_t                    *list,
+                                           function_t                 function,
+                                           size_t                     threads_number);
+/* fold(value, data) runs over each sublist in order, join(left, right) */
+/* merges neighbouring sublists and must be associative.                */
+template <typename list_t, typename value_t, typename fold_t, typename join_t>
+list_error_t linked_list_parallel_reduce (list_t                     *list,
+                                          value_t                     identity,
+                                          fold_t                      fold,
+                                          join_t                      join,
+                                          value_t                    *output,
+                                          size_t                      threads_number);
+
+size_t       list_parallel_threads       (size_t                      threads_number);
+template <typename function_t>
+void         list_parallel_run           (size_t                      threads_number,
+                                          size_t                      tasks_number,
+                                          function_t                  function);
+template <typename list_t>
+list_error_t list_sublists_build         (list_t                     *list,
+                                          size_t                      threads_number,
+                                          list_sublists_t            *sublists);
+void         list_sublists_free          (list_sublists_t            *sublists);
+template <typename list_t, typename visit_t>
+void         list_sublists_walk          (list_t                     *list,
+                                          const list_sublists_t      *sublists,
+                                          size_t                      threads_number,
+                                          visit_t                     visit);
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_rank(list_t *list, size_t *positions, size_t threads_number) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(positions != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    threads_number = list_parallel_threads(threads_number);
+
+    list_sublists_t sublists   = {};
+    list_error_t    error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_sublists_build(list, threads_number, &sublists)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    /* Free slots and the zero element get SIZE_MAX. */
+    size_t slots = list->capacity + 1;
+    size_t chunk = (slots + threads_number - 1) / threads_number;
+    list_parallel_run(threads_number, threads_number, [=](size_t task) {
+        size_t last = chunk * (task + 1) < slots ? chunk * (task + 1) : slots;
+        for(size_t slot = chunk * task; slot < last; slot++) {
+            positions[slot] = SIZE_MAX;
+        }
+    });
+
+    list_sublists_walk(list, &sublists, threads_number, [=](size_t position, size_t node) {
+        positions[node] = position;
+    });
+
+    list_sublists_free(&sublists);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_parallel_export(list_t                     *list,
+                                         typename list_t::elem_type *output,
+                                         size_t                      threads_number) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    threads_number = list_parallel_threads(threads_number);
+
+    list_sublists_t sublists   = {};
+    list_error_t    error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_sublists_build(list, threads_number, &sublists)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list_sublists_walk(list, &sublists, threads_number, [=](size_t position, size_t node) {
+        output[position] = linked_list_data(list, node);
+    });
+
+    list_sublists_free(&sublists);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename function_t>
+list_error_t linked_list_parallel_for_each(list_t *list, function_t function, size_t threads_number) {
+    LINKED_LIST_VERIFY(list);
+
+    threads_number = list_parallel_threads(threads_number);
+
+    list_sublists_t sublists   = {};
+    list_error_t    error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_sublists_build(list, threads_number, &sublists)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list_sublists_walk(list, &sublists, threads_number, [=, &function](size_t position, size_t node) {
+        function(position, node, linked_list_data(list, node));
+    });
+
+    list_sublists_free(&sublists);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Every sublist is a logical segment, so partial results are joined */
+/* in the order the serial pass found the sublists in.                */
+template <typename list_t, typename value_t, typename fold_t, typename join_t>
+list_error_t linked_list_parallel_reduce(list_t  *list,
+                                         value_t  identity,
+                                         fold_t   fold,
+                                         join_t   join,
+                                         value_t *output,
+                                         size_t   threads_number) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    threads_number = list_parallel_threads(threads_number);
+
+    list_sublists_t sublists   = {};
+    list_error_t    error_code = LINKED_LIST_SUCCESS;
+    if((error_code = list_sublists_build(list, threads_number, &sublists)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    std::vector<value_t> partial(sublists.number, identity);
+    list_parallel_run(threads_number, sublists.number, [&](size_t sublist) {
+        value_t value = identity;
+        size_t  node  = sublists.heads[sublist];
+        for(size_t step = 0; step < sublists.lengths[sublist]; step++) {
+            value = fold(value, linked_list_data(list, node));
+            node  = linked_list_next(list, node);
+        }
+        partial[sublist] = value;
+    });
+
+    value_t result = identity;
+    for(size_t sublist = 0; sublist != SIZE_MAX && sublists.number != 0; sublist = sublists.successors[sublist]) {
+        result = join(result, partial[sublist]);
+    }
+    *output = result;
+
+    list_sublists_free(&sublists);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Tasks are handed out one at a time, so uneven sublists still keep */
+/* every thread busy. The calling thread works as thread 0.          */
+template <typename function_t>
+void list_parallel_run(size_t threads_number, size_t tasks_number, function_t function) {
+    std::atomic<size_t> next_task(0);
+    auto worker = [&]() {
+        for(size_t task = next_task++; task < tasks_number; task = next_task++) {
+            function(task);
+        }
+    };
+
+    if(threads_number > tasks_number) {
+        threads_number = tasks_number;
+    }
+    std::vector<std::thread> threads;
+    for(size_t thread = 1; thread < threads_number; thread++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for(size_t thread = 0; thread < threads.size(); thread++) {
+        threads[thread].join();
+    }
+}
+
+/*=======================================================================================*/
+
+/* Sublist 0 starts at the head, the others at one live node picked at */
+/* random from each of equal slices of the array.                       */
+template <typename list_t>
+list_error_t list_sublists_build(list_t *list, size_t threads_number, list_sublists_t *sublists) {
+    typedef typename list_t::index_type index_t;
+
+    const index_t poison = list_index_traits_t<index_t>::poison;
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+
+    size_t slots   = list->capacity + 1;
+    size_t wanted  = threads_number * list_splitters_per_thread;
+    if(wanted > list->size) {
+        wanted = list->size == 0 ? 1 : list->size;
+    }
+
+    sublists->heads       = (size_t   *)calloc(wanted, sizeof(size_t));
+    sublists->lengths     = (size_t   *)calloc(wanted, sizeof(size_t));
+    sublists->offsets     = (size_t   *)calloc(wanted, sizeof(size_t));
+    sublists->successors  = (size_t   *)calloc(wanted, sizeof(size_t));
+    sublists->splitter_of = (uint32_t *)calloc(slots,  sizeof(uint32_t));
+    if(sublists->heads      == NULL || sublists->lengths     == NULL ||
+       sublists->offsets    == NULL || sublists->successors  == NULL ||
+       sublists->splitter_of == NULL) {
+        list_sublists_free(sublists);
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    sublists->number = 0;
+    if(list->size == 0) {
+        return LINKED_LIST_SUCCESS;
+    }
+
+    size_t head = linked_list_next(list, 0);
+    sublists->heads[sublists->number++] = head;
+    sublists->splitter_of[head]         = 1;
+
+    uint64_t random = 0x9e3779b97f4a7c15ull;
+    size_t   slice  = slots / wanted;
+    for(size_t splitter = 1; splitter < wanted && slice != 0; splitter++) {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+
+        size_t first = splitter * slice;
+        for(size_t probe = 0; probe < slice; probe++) {
+            size_t slot = first + (size_t)((random + probe) % slice);
+            if(slot != 0 && linked_list_prev(list, slot) != poison && sublists->splitter_of[slot] == 0) {
+                sublists->splitter_of[slot]         = (uint32_t)(sublists->number + 1);
+                sublists->heads[sublists->number++] = slot;
+                break;
+            }
+        }
+    }
+
+    /* The walks only read splitter_of of nodes in their own sublist */
+    /* and of splitters, which no longer change.                     */
+    list_parallel_run(threads_number, sublists->number, [=](size_t sublist) {
+        size_t length = 0;
+        size_t node   = sublists->heads[sublist];
+        do {
+            length++;
+            node = linked_list_next(list, node);
+        } while(node != 0 && sublists->splitter_of[node] == 0);
+
+        sublists->lengths   [sublist] = length;
+        sublists->successors[sublist] = node == 0 ? SIZE_MAX : sublists->splitter_of[node] - 1;
+    });
+
+    size_t offset = 0;
+    for(size_t sublist = 0; sublist != SIZE_MAX; sublist = sublists->successors[sublist]) {
+        sublists->offsets[sublist] = offset;
+        offset += sublists->lengths[sublist];
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Calls visit(position, real_index) for every node, one sublist per task. */
+template <typename list_t, typename visit_t>
+void list_sublists_walk(list_t                *list,
+                        const list_sublists_t *sublists,
+                        size_t                 threads_number,
+                        visit_t                visit) {
+    list_parallel_run(threads_number, sublists->number, [&](size_t sublist) {
+        size_t position = sublists->offsets[sublist];
+        size_t node     = sublists->heads  [sublist];
+        for(size_t step = 0; step < sublists->lengths[sublist]; step++) {
+            visit(position + step, node);
+            node = linked_list_next(list, node);
+        }
+    });
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_PARALLEL(__prefix, __list_t)                                 \
+    __prefix template list_error_t linked_list_rank           <__list_t>(                    \
+        __list_t *, size_t *, size_t);                                                       \
+    __prefix template list_error_t linked_list_parallel_export<__list_t>(                    \
+        __list_t *, __list_t::elem_type *, size_t);
+
+#endif
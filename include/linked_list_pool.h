@@ -0,0 +1,362 @@
+#ifndef LINKED_LIST_POOL_H
+#define LINKED_LIST_POOL_H
+
+/*=======================================================================================*/
+
+/* Many small lists sharing one node array. The pool is an ordinary list made */
+/* by linked_list_ctor whose own chain stays empty: its free list and growth  */
+/* serve the pooled lists, each of which owns one sentinel slot of the pool.  */
+/* Real indices of pooled nodes are pool slots, a list is walked with         */
+/* linked_list_next(list->pool, node) until the sentinel comes back. While    */
+/* pooled lists live the pool itself is only passed to linked_list_dtor and   */
+/* linked_list_set_*, and it can not have an order index.                     */
+template <typename pool_t>
+struct basic_pooled_list_t {
+    typedef pool_t                      pool_type;
+    typedef typename pool_t::elem_type  elem_type;
+    typedef typename pool_t::index_type index_type;
+
+    pool_t *pool;
+    size_t  sentinel;
+    size_t  size;
+};
+
+typedef basic_pooled_list_t<linked_list_t> pooled_linked_list_t;
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_VERIFICATION
+    #define LINKED_LIST_VERIFY_POOLED(__list)                                       \
+        LINKED_LIST_VERIFY_CALL(pooled_list_verify_entry((__list)))
+
+    template <typename plist_t>
+    list_error_t pooled_list_verify      (plist_t *list);
+    template <typename plist_t>
+    list_error_t pooled_list_verify_entry(plist_t *list);
+#else
+    #define LINKED_LIST_VERIFY_POOLED(...)
+#endif
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_ctor          (plist_t                               *list,
+                                        typename plist_t::pool_type           *pool);
+template <typename plist_t>
+list_error_t pooled_list_insert_after  (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        const typename plist_t::elem_type     &data);
+template <typename plist_t>
+list_error_t pooled_list_insert_after  (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        typename plist_t::elem_type          &&data);
+template <typename plist_t>
+list_error_t pooled_list_insert_before (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        const typename plist_t::elem_type     &data);
+template <typename plist_t>
+list_error_t pooled_list_insert_before (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        typename plist_t::elem_type          &&data);
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_after (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        args_t                             &&...args);
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_before(plist_t                               *list,
+                                        size_t                                 real_index,
+                                        args_t                             &&...args);
+template <typename plist_t>
+list_error_t pooled_list_remove        (plist_t                               *list,
+                                        size_t                                 real_index,
+                                        typename plist_t::elem_type           *output);
+template <typename plist_t>
+list_error_t pooled_list_dtor          (plist_t                               *list);
+
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_between(plist_t    *list,
+                                         size_t      prev_node,
+                                         size_t      next_node,
+                                         args_t  &&...args);
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_ctor(plist_t *list, typename plist_t::pool_type *pool) {
+    C_ASSERT(list                    != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(pool                    != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(pool->order_index.tree  == NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    typedef typename plist_t::index_type index_t;
+
+    size_t       sentinel   = 0;
+    list_error_t error_code = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_find_free(pool, 0, 0, &sentinel)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    linked_list_prev(pool, sentinel) = (index_t)sentinel;
+    linked_list_next(pool, sentinel) = (index_t)sentinel;
+
+    pool->size++;
+    pool->is_linear = false;
+
+    list->pool      = pool;
+    list->sentinel  = sentinel;
+    list->size      = 0;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_insert_after(plist_t                           *list,
+                                      size_t                             real_index,
+                                      const typename plist_t::elem_type &data) {
+    return pooled_list_emplace_after(list, real_index, data);
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_insert_after(plist_t                      *list,
+                                      size_t                        real_index,
+                                      typename plist_t::elem_type &&data) {
+    return pooled_list_emplace_after(list, real_index, std::move(data));
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_insert_before(plist_t                           *list,
+                                       size_t                             real_index,
+                                       const typename plist_t::elem_type &data) {
+    return pooled_list_emplace_before(list, real_index, data);
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_insert_before(plist_t                      *list,
+                                       size_t                        real_index,
+                                       typename plist_t::elem_type &&data) {
+    return pooled_list_emplace_before(list, real_index, std::move(data));
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_after(plist_t *list, size_t real_index, args_t &&...args) {
+    LINKED_LIST_VERIFY_POOLED(list);
+    C_ASSERT(real_index < list->pool->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list->pool, real_index);
+
+    return pooled_list_emplace_between(list,
+                                       real_index,
+                                       linked_list_next(list->pool, real_index),
+                                       std::forward<args_t>(args)...);
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_before(plist_t *list, size_t real_index, args_t &&...args) {
+    LINKED_LIST_VERIFY_POOLED(list);
+    C_ASSERT(real_index < list->pool->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+    LINKED_LIST_VERIFY_NODE(list->pool, real_index);
+
+    return pooled_list_emplace_between(list,
+                                       linked_list_prev(list->pool, real_index),
+                                       real_index,
+                                       std::forward<args_t>(args)...);
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t>
+list_error_t pooled_list_remove(plist_t                      *list,
+                                size_t                        real_index,
+                                typename plist_t::elem_type  *output) {
+    LINKED_LIST_VERIFY_POOLED(list);
+    C_ASSERT(real_index != list->sentinel           , return LINKED_LIST_INVALID_INDEX );
+    C_ASSERT(real_index != 0                        , return LINKED_LIST_INVALID_INDEX );
+    C_ASSERT(real_index <  list->pool->capacity + 1 , return LINKED_LIST_INVALID_INDEX );
+    C_ASSERT(output     != NULL                     , return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(list->size != 0                        , return LINKED_LIST_INVALID_INDEX );
+    LINKED_LIST_VERIFY_NODE(list->pool, real_index);
+
+    typedef typename plist_t::index_type index_t;
+
+    typename plist_t::pool_type *pool = list->pool;
+
+    *output                            = std::move(linked_list_data(pool, real_index));
+
+    index_t prev_node                  = linked_list_prev(pool, real_index);
+    index_t next_node                  = linked_list_next(pool, real_index);
+
+    linked_list_next(pool, prev_node)  = next_node;
+    linked_list_prev(pool, next_node)  = prev_node;
+
+    list_release_slot(pool, real_index);
+
+    pool->size--;
+    list->size--;
+    LINKED_LIST_STATS_ADD(pool, removes, 1);
+
+    LINKED_LIST_VERIFY_NODE(pool, prev_node);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Gives the nodes and the sentinel back to the pool in O(1), they are */
+/* poisoned later as with linked_list_clear. A pool allocating nearest */
+/* marks them one by one.                                              */
+template <typename plist_t>
+list_error_t pooled_list_dtor(plist_t *list) {
+    LINKED_LIST_VERIFY_POOLED(list);
+
+    typename plist_t::pool_type *pool = list->pool;
+
+    list_release_chain(pool, list->sentinel, linked_list_prev(pool, list->sentinel), list->size + 1);
+
+    pool->size -= list->size + 1;
+    LINKED_LIST_STATS_ADD(pool, removes, list->size);
+
+    list->pool     = NULL;
+    list->sentinel = 0;
+    list->size     = 0;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename plist_t, typename... args_t>
+list_error_t pooled_list_emplace_between(plist_t    *list,
+                                         size_t      prev_node,
+                                         size_t      next_node,
+                                         args_t  &&...args) {
+    typedef typename plist_t::index_type index_t;
+
+    typename plist_t::pool_type *pool = list->pool;
+
+    size_t       insertion_index = 0;
+    list_error_t error_code      = LINKED_LIST_SUCCESS;
+    if((error_code = linked_list_find_free(pool, prev_node, next_node, &insertion_index)) != LINKED_LIST_SUCCESS) {
+        return error_code;
+    }
+
+    list_construct_data(&linked_list_data(pool, insertion_index), std::forward<args_t>(args)...);
+    linked_list_prev(pool, insertion_index) = (index_t)prev_node;
+    linked_list_next(pool, insertion_index) = (index_t)next_node;
+
+    linked_list_next(pool, prev_node)       = (index_t)insertion_index;
+    linked_list_prev(pool, next_node)       = (index_t)insertion_index;
+
+    pool->size++;
+    list->size++;
+    LINKED_LIST_STATS_ADD (pool, inserts, 1);
+    LINKED_LIST_STATS_PEAK(pool);
+
+    LINKED_LIST_VERIFY_NODE(pool, insertion_index);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_VERIFICATION
+    template <typename plist_t>
+    list_error_t pooled_list_verify(plist_t *list) {
+        if(list == NULL || list->pool == NULL) {
+            return LINKED_LIST_NULL;
+        }
+
+        typename plist_t::pool_type *pool = list->pool;
+
+        if(list_storage_block(pool) == NULL) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        if(list->size >= pool->size || list->sentinel > pool->capacity) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+
+        list_error_t error_code = LINKED_LIST_SUCCESS;
+
+        size_t counter = 0;
+        size_t node    = list->sentinel;
+        do {
+            if((error_code = linked_list_verify_links(pool, node)) != LINKED_LIST_SUCCESS) {
+                return error_code;
+            }
+            if(++counter > list->size + 1) {
+                return LINKED_LIST_LOOP_ERROR;
+            }
+            node = linked_list_next(pool, node);
+        } while(node != list->sentinel);
+
+        if(counter != list->size + 1) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    /* Levels of the pool apply, whole list checks walk this list only. */
+    template <typename plist_t>
+    list_error_t pooled_list_verify_entry(plist_t *list) {
+        if(list == NULL || list->pool == NULL) {
+            return LINKED_LIST_NULL;
+        }
+
+        typename plist_t::pool_type *pool = list->pool;
+
+        switch(pool->verify_level) {
+            case LINKED_LIST_VERIFY_OFF: {
+                return LINKED_LIST_SUCCESS;
+            }
+            case LINKED_LIST_VERIFY_FULL: {
+                return pooled_list_verify(list);
+            }
+            case LINKED_LIST_VERIFY_SAMPLED: {
+                if(--pool->verify_countdown == 0) {
+                    pool->verify_countdown = pool->verify_period;
+                    return pooled_list_verify(list);
+                }
+                break;
+            }
+            case LINKED_LIST_VERIFY_LOCAL:
+            default: {
+                break;
+            }
+        }
+
+        if(list_storage_block(pool) == NULL) {
+            return LINKED_LIST_NULL_DATA;
+        }
+        if(list->size >= pool->size || pool->size > pool->capacity) {
+            return LINKED_LIST_INVALID_SIZE;
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+#endif
+
+/*=======================================================================================*/
+
+/* Explicit instantiation of the pooled API for one pooled list type. */
+#define LINKED_LIST_INSTANTIATE_POOLED(__prefix, __plist_t)                                  \
+    __prefix template list_error_t pooled_list_ctor         <__plist_t>(                     \
+        __plist_t *, __plist_t::pool_type *);                                                \
+    __prefix template list_error_t pooled_list_insert_after <__plist_t>(                     \
+        __plist_t *, size_t, const __plist_t::elem_type &);                                  \
+    __prefix template list_error_t pooled_list_insert_after <__plist_t>(                     \
+        __plist_t *, size_t, __plist_t::elem_type &&);                                       \
+    __prefix template list_error_t pooled_list_insert_before<__plist_t>(                     \
+        __plist_t *, size_t, const __plist_t::elem_type &);                                  \
+    __prefix template list_error_t pooled_list_insert_before<__plist_t>(                     \
+        __plist_t *, size_t, __plist_t::elem_type &&);                                       \
+    __prefix template list_error_t pooled_list_remove       <__plist_t>(                     \
+        __plist_t *, size_t, __plist_t::elem_type *);                                        \
+    __prefix template list_error_t pooled_list_dtor         <__plist_t>(__plist_t *);
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef LINKED_LIST_QUEUE_H
+#define LINKED_LIST_QUEUE_H
+
+#include <atomic>
+
+/*=======================================================================================*/
+
+/* A bounded channel on the index-linked array: producers push at the tail,  */
+/* one consumer pops at the head. Slot 0 starts as the sentinel and the     */
+/* sentinel moves forward with every pop, as in an intrusive MPSC queue.    */
+/* Producers take slots from a lock-free free stack, the consumer returns   */
+/* them in batches. At most capacity messages are queued at once, counted   */
+/* by used. No operation blocks: a full or empty queue is reported and the  */
+/* caller decides whether to spin, yield or sleep.                          */
+enum list_queue_mode_t {
+    LINKED_LIST_QUEUE_SPSC = 0, /* one producer, one consumer       */
+    LINKED_LIST_QUEUE_MPSC = 1, /* any number of producers, one consumer */
+};
+
+static const size_t list_queue_cache_line    = 64;
+static const size_t list_queue_release_batch = 32;
+
+template <typename elem_t>
+struct list_queue_node_t {
+    elem_t                data;
+    std::atomic<uint32_t> next;
+};
+
+template <typename elem_t>
+struct basic_list_queue_t {
+    static_assert(std::is_trivially_copyable<elem_t>::value,
+                  "queue payload must be trivially copyable");
+
+    typedef elem_t                    elem_type;
+    typedef uint32_t                  index_type;
+    typedef list_queue_node_t<elem_t> node_type;
+
+    node_type         *array;
+    size_t             capacity;
+    list_queue_mode_t  mode;
+
+    /* Written by producers. */
+    alignas(list_queue_cache_line) std::atomic<uint32_t> tail;
+    /* Messages pushed or being pushed and not popped yet, up to capacity. */
+    alignas(list_queue_cache_line) std::atomic<size_t>   used;
+    /* Free stack, top slot in the low half, ABA counter in the high half. */
+    alignas(list_queue_cache_line) std::atomic<uint64_t> free_top;
+    /* Owned by the consumer. */
+    alignas(list_queue_cache_line) uint32_t              head;
+    uint32_t                                             released[list_queue_release_batch];
+    size_t                                               released_number;
+};
+
+typedef basic_list_queue_t<data_t> list_queue_t;
+
+/*=======================================================================================*/
+
+template <typename queue_t>
+list_error_t list_queue_ctor    (queue_t                           *queue,
+                                 size_t                             capacity,
+                                 list_queue_mode_t                  mode);
+template <typename queue_t>
+list_error_t list_queue_try_push(queue_t                           *queue,
+                                 const typename queue_t::elem_type &data);
+template <typename queue_t>
+list_error_t list_queue_try_pop (queue_t                           *queue,
+                                 typename queue_t::elem_type       *output);
+template <typename queue_t>
+list_error_t list_queue_dtor    (queue_t                           *queue);
+
+template <typename queue_t>
+void         list_queue_release (queue_t                           *queue);
+
+/*=======================================================================================*/
+
+/* The array holds capacity message slots, the sentinel and the slots   */
+/* waiting in the consumer batch, so a push that got under the capacity */
+/* always finds a free slot.                                            */
+template <typename queue_t>
+list_error_t list_queue_ctor(queue_t *queue, size_t capacity, list_queue_mode_t mode) {
+    C_ASSERT(queue != NULL                    , return LINKED_LIST_NULL         );
+    C_ASSERT(mode  <= LINKED_LIST_QUEUE_MPSC  , return LINKED_LIST_INVALID_INDEX);
+
+    typedef typename queue_t::node_type node_t;
+    const uint32_t poison = list_index_traits_t<uint32_t>::poison;
+
+    size_t slots = capacity + 1 + list_queue_release_batch;
+    if(capacity == 0 || slots > list_index_traits_t<uint32_t>::max_capacity) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Queue capacity does not fit in index type.\r\n");
+        return LINKED_LIST_INDEX_OVERFLOW;
+    }
+
+    queue->array = (node_t *)list_block_allocate(NULL, slots * sizeof(node_t));
+    if(queue->array == NULL) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while allocating data memory.\r\n");
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    /* Slots 1..slots-1 form the free stack in order. */
+    for(size_t slot = 1; slot + 1 < slots; slot++) {
+        queue->array[slot].next.store((uint32_t)(slot + 1), std::memory_order_relaxed);
+    }
+    queue->array[slots - 1].next.store(poison, std::memory_order_relaxed);
+    queue->array[0]        .next.store(poison, std::memory_order_relaxed);
+
+    queue->capacity        = capacity;
+    queue->mode            = mode;
+    queue->head            = 0;
+    queue->released_number = 0;
+    queue->tail    .store(0, std::memory_order_relaxed);
+    queue->used    .store(0, std::memory_order_relaxed);
+    queue->free_top.store(1, std::memory_order_release);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename queue_t>
+list_error_t list_queue_try_push(queue_t *queue, const typename queue_t::elem_type &data) {
+    C_ASSERT(queue != NULL, return LINKED_LIST_NULL);
+
+    const uint32_t poison = list_index_traits_t<uint32_t>::poison;
+
+    /* Reserves a place first. The acquire pairs with the release of the */
+    /* consumer, so the free stack it filled is visible.                 */
+    size_t used = queue->used.load(std::memory_order_acquire);
+    if(queue->mode == LINKED_LIST_QUEUE_SPSC) {
+        if(used >= queue->capacity) {
+            return LINKED_LIST_QUEUE_FULL;
+        }
+        queue->used.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        do {
+            if(used >= queue->capacity) {
+                return LINKED_LIST_QUEUE_FULL;
+            }
+        } while(!queue->used.compare_exchange_weak(used, used + 1,
+                                                   std::memory_order_acquire,
+                                                   std::memory_order_acquire));
+    }
+
+    uint64_t top = queue->free_top.load(std::memory_order_acquire);
+    uint32_t slot = 0;
+    do {
+        slot = (uint32_t)top;
+        if(slot == poison) {
+            queue->used.fetch_sub(1, std::memory_order_relaxed);
+            return LINKED_LIST_QUEUE_FULL;
+        }
+    } while(!queue->free_top.compare_exchange_weak(
+                top,
+                (((top >> 32) + 1) << 32) | queue->array[slot].next.load(std::memory_order_relaxed),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire));
+
+    queue->array[slot].data = data;
+    queue->array[slot].next.store(poison, std::memory_order_relaxed);
+
+    uint32_t prev = 0;
+    if(queue->mode == LINKED_LIST_QUEUE_SPSC) {
+        prev = queue->tail.load(std::memory_order_relaxed);
+        queue->tail.store(slot, std::memory_order_relaxed);
+    }
+    else {
+        prev = queue->tail.exchange(slot, std::memory_order_acq_rel);
+    }
+    /* Publishes the message, the consumer reads it after this store. */
+    queue->array[prev].next.store(slot, std::memory_order_release);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* A producer that swapped the tail but has not linked its node yet makes */
+/* the queue look empty for a moment, the next call sees the message.     */
+template <typename queue_t>
+list_error_t list_queue_try_pop(queue_t *queue, typename queue_t::elem_type *output) {
+    C_ASSERT(queue  != NULL, return LINKED_LIST_NULL          );
+    C_ASSERT(output != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    uint32_t head = queue->head;
+    uint32_t next = queue->array[head].next.load(std::memory_order_acquire);
+    if(next == list_index_traits_t<uint32_t>::poison) {
+        return LINKED_LIST_QUEUE_EMPTY;
+    }
+
+    *output     = queue->array[next].data;
+    queue->head = next;
+
+    queue->released[queue->released_number++] = head;
+    if(queue->released_number == list_queue_release_batch) {
+        list_queue_release(queue);
+    }
+    queue->used.fetch_sub(1, std::memory_order_release);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename queue_t>
+list_error_t list_queue_dtor(queue_t *queue) {
+    C_ASSERT(queue != NULL, return LINKED_LIST_NULL);
+
+    size_t slots = queue->capacity + 1 + list_queue_release_batch;
+    list_block_free(NULL, queue->array, slots * sizeof(typename queue_t::node_type));
+    queue->array    = NULL;
+    queue->capacity = 0;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Chains the consumer batch and pushes it on the free stack with one CAS. */
+template <typename queue_t>
+void list_queue_release(queue_t *queue) {
+    size_t number = queue->released_number;
+    for(size_t slot = 0; slot + 1 < number; slot++) {
+        queue->array[queue->released[slot]].next.store(queue->released[slot + 1],
+                                                       std::memory_order_relaxed);
+    }
+
+    std::atomic<uint32_t> &last = queue->array[queue->released[number - 1]].next;
+    uint64_t top     = queue->free_top.load(std::memory_order_relaxed);
+    uint64_t new_top = 0;
+    do {
+        last.store((uint32_t)top, std::memory_order_relaxed);
+        new_top = (((top >> 32) + 1) << 32) | queue->released[0];
+    } while(!queue->free_top.compare_exchange_weak(top, new_top,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    queue->released_number = 0;
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_QUEUE(__prefix, __queue_t)                                   \
+    __prefix template list_error_t list_queue_ctor    <__queue_t>(                           \
+        __queue_t *, size_t, list_queue_mode_t);                                             \
+    __prefix template list_error_t list_queue_try_push<__queue_t>(                           \
+        __queue_t *, const __queue_t::elem_type &);                                          \
+    __prefix template list_error_t list_queue_try_pop <__queue_t>(                           \
+        __queue_t *, __queue_t::elem_type *);                                                \
+    __prefix template list_error_t list_queue_dtor    <__queue_t>(__queue_t *);
+
+#endif
@@ -0,0 +1,372 @@
+#ifndef LINKED_LIST_SCAN_H
+#define LINKED_LIST_SCAN_H
+
+#include <limits.h>
+
+/*=======================================================================================*/
+
+/* Queries that do not care about order read the array front to back      */
+/* instead of walking the chain, a slot is live while its prev is not      */
+/* poison. Lists of int in the soa layout are scanned with SSE2 or AVX2,   */
+/* whichever the compiler targets, LINKED_LIST_OFF_SIMD keeps the scalar   */
+/* loop. Results are real indices, 0 when nothing matches.                 */
+#if !defined(LINKED_LIST_OFF_SIMD) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define LINKED_LIST_SIMD_AVX2
+#elif !defined(LINKED_LIST_OFF_SIMD) && defined(__SSE2__)
+    #include <emmintrin.h>
+    #define LINKED_LIST_SIMD_SSE2
+#endif
+
+/*=======================================================================================*/
+
+/* Lowest live slot holding value. */
+template <typename list_t>
+list_error_t linked_list_find (list_t                           *list,
+                               const typename list_t::elem_type &value,
+                               size_t                           *real_index);
+template <typename list_t>
+list_error_t linked_list_count(list_t                           *list,
+                               const typename list_t::elem_type &value,
+                               size_t                           *count);
+template <typename list_t, typename sum_t>
+list_error_t linked_list_sum  (list_t                           *list,
+                               sum_t                            *sum);
+/* Lowest live slot holding the smallest or the largest value. */
+template <typename list_t>
+list_error_t linked_list_min  (list_t                           *list,
+                               size_t                           *real_index);
+template <typename list_t>
+list_error_t linked_list_max  (list_t                           *list,
+                               size_t                           *real_index);
+
+template <typename list_t>
+size_t       list_scan_last   (list_t                           *list);
+
+/*=======================================================================================*/
+
+/* Kernels scan slots first..last, skipping dead ones only when masked */
+/* is set: a linear list has no dead slots below its size.             */
+template <typename list_t, typename = void>
+struct list_scan_kernel_t {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+
+    static bool live(list_t *list, size_t slot, bool masked) {
+        return !masked || linked_list_prev(list, slot) != list_index_traits_t<index_t>::poison;
+    }
+
+    static size_t find(list_t *list, const elem_t &value, size_t first, size_t last, bool masked) {
+        for(size_t slot = first; slot <= last; slot++) {
+            if(live(list, slot, masked) && linked_list_data(list, slot) == value) {
+                return slot;
+            }
+        }
+        return 0;
+    }
+
+    static size_t count(list_t *list, const elem_t &value, size_t first, size_t last, bool masked) {
+        size_t count = 0;
+        for(size_t slot = first; slot <= last; slot++) {
+            count += live(list, slot, masked) && linked_list_data(list, slot) == value;
+        }
+        return count;
+    }
+
+    template <typename sum_t>
+    static sum_t sum(list_t *list, size_t first, size_t last, bool masked) {
+        sum_t sum = sum_t();
+        for(size_t slot = first; slot <= last; slot++) {
+            if(live(list, slot, masked)) {
+                sum += linked_list_data(list, slot);
+            }
+        }
+        return sum;
+    }
+
+    static size_t extreme(list_t *list, size_t first, size_t last, bool masked, bool maximum) {
+        size_t best = 0;
+        for(size_t slot = first; slot <= last; slot++) {
+            if(!live(list, slot, masked)) {
+                continue;
+            }
+            if(best == 0 ||
+               ( maximum && linked_list_data(list, best) < linked_list_data(list, slot)) ||
+               (!maximum && linked_list_data(list, slot) < linked_list_data(list, best))) {
+                best = slot;
+            }
+        }
+        return best;
+    }
+};
+
+/*=======================================================================================*/
+
+#if defined(LINKED_LIST_SIMD_AVX2) || defined(LINKED_LIST_SIMD_SSE2)
+
+    /* Lane helpers, a vector holds list_simd_lanes payloads of int. The dead */
+    /* mask of a block has all bits set in lanes whose prev is poison.        */
+    #ifdef LINKED_LIST_SIMD_AVX2
+        typedef __m256i list_simd_t;
+        static const size_t list_simd_lanes = 8;
+
+        inline list_simd_t list_simd_load  (const void *source) { return _mm256_loadu_si256((const __m256i *)source); }
+        inline list_simd_t list_simd_set   (int value)          { return _mm256_set1_epi32(value); }
+        inline list_simd_t list_simd_equal (list_simd_t left, list_simd_t right) { return _mm256_cmpeq_epi32(left, right); }
+        inline list_simd_t list_simd_above (list_simd_t left, list_simd_t right) { return _mm256_cmpgt_epi32(left, right); }
+        inline list_simd_t list_simd_clear (list_simd_t mask, list_simd_t value) { return _mm256_andnot_si256(mask, value); }
+        inline list_simd_t list_simd_select(list_simd_t mask, list_simd_t taken, list_simd_t other) {
+            return _mm256_blendv_epi8(other, taken, mask);
+        }
+        inline unsigned    list_simd_bits  (list_simd_t mask) {
+            return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(mask));
+        }
+
+        inline list_simd_t list_simd_dead(const uint32_t *prev) {
+            return _mm256_cmpeq_epi32(list_simd_load(prev), _mm256_set1_epi32(-1));
+        }
+        /* 64 bit compares, then the low halves of both vectors in lane order. */
+        inline list_simd_t list_simd_dead(const uint64_t *prev) {
+            const __m256i ones  = _mm256_set1_epi32(-1);
+            const __m256i halves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+            __m256i low  = _mm256_permutevar8x32_epi32(_mm256_cmpeq_epi64(list_simd_load(prev),     ones), halves);
+            __m256i high = _mm256_permutevar8x32_epi32(_mm256_cmpeq_epi64(list_simd_load(prev + 4), ones), halves);
+            return _mm256_permute2x128_si256(low, high, 0x20);
+        }
+
+        /* Sign extends to four 64 bit lanes so sums do not overflow. */
+        inline list_simd_t list_simd_widen_add(list_simd_t sum, list_simd_t value) {
+            sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+            return _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+        }
+    #else
+        typedef __m128i list_simd_t;
+        static const size_t list_simd_lanes = 4;
+
+        inline list_simd_t list_simd_load  (const void *source) { return _mm_loadu_si128((const __m128i *)source); }
+        inline list_simd_t list_simd_set   (int value)          { return _mm_set1_epi32(value); }
+        inline list_simd_t list_simd_equal (list_simd_t left, list_simd_t right) { return _mm_cmpeq_epi32(left, right); }
+        inline list_simd_t list_simd_above (list_simd_t left, list_simd_t right) { return _mm_cmpgt_epi32(left, right); }
+        inline list_simd_t list_simd_clear (list_simd_t mask, list_simd_t value) { return _mm_andnot_si128(mask, value); }
+        inline list_simd_t list_simd_select(list_simd_t mask, list_simd_t taken, list_simd_t other) {
+            return _mm_or_si128(_mm_and_si128(mask, taken), _mm_andnot_si128(mask, other));
+        }
+        inline unsigned    list_simd_bits  (list_simd_t mask) {
+            return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(mask));
+        }
+
+        inline list_simd_t list_simd_dead(const uint32_t *prev) {
+            return _mm_cmpeq_epi32(list_simd_load(prev), _mm_set1_epi32(-1));
+        }
+        /* SSE2 has no 64 bit compare: both halves of a dead prev are all ones. */
+        inline list_simd_t list_simd_dead(const uint64_t *prev) {
+            const __m128i ones = _mm_set1_epi32(-1);
+            __m128i low  = _mm_cmpeq_epi32(list_simd_load(prev),     ones);
+            __m128i high = _mm_cmpeq_epi32(list_simd_load(prev + 2), ones);
+            low  = _mm_and_si128(low,  _mm_shuffle_epi32(low,  _MM_SHUFFLE(2, 3, 0, 1)));
+            high = _mm_and_si128(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+            return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(low), _mm_castsi128_ps(high),
+                                                   _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+
+        inline list_simd_t list_simd_widen_add(list_simd_t sum, list_simd_t value) {
+            __m128i sign = _mm_srai_epi32(value, 31);
+            sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(value, sign));
+            return _mm_add_epi64(sum, _mm_unpackhi_epi32(value, sign));
+        }
+    #endif
+
+    template <size_t index_size>
+    struct list_simd_index_t {};
+    template <>
+    struct list_simd_index_t<4> { typedef uint32_t type; };
+    template <>
+    struct list_simd_index_t<8> { typedef uint64_t type; };
+
+    /*=======================================================================================*/
+
+    /* int payloads in the soa layout: data and prev are streamed separately, */
+    /* the scalar kernel finishes the slots that do not fill a vector.        */
+    template <typename index_t>
+    struct list_scan_kernel_t<basic_linked_list_t<int, index_t, list_soa_storage_t>,
+                              typename std::enable_if<sizeof(index_t) == 4 ||
+                                                      sizeof(index_t) == 8>::type> {
+        typedef basic_linked_list_t<int, index_t, list_soa_storage_t>    list_t;
+        /* The second argument is never void here, so this is the scalar kernel. */
+        typedef list_scan_kernel_t<list_t, bool>                         scalar_t;
+        typedef typename list_simd_index_t<sizeof(index_t)>::type        prev_t;
+
+        static list_simd_t block(list_t *list, size_t slot, bool masked, list_simd_t *dead) {
+            *dead = masked ? list_simd_dead((const prev_t *)list->prev_array + slot) : list_simd_set(0);
+            return list_simd_load(list->data_array + slot);
+        }
+
+        static size_t find(list_t *list, int value, size_t first, size_t last, bool masked) {
+            list_simd_t target = list_simd_set(value);
+            size_t      slot   = first;
+            for(; slot + list_simd_lanes <= last + 1; slot += list_simd_lanes) {
+                list_simd_t dead = {};
+                list_simd_t data = block(list, slot, masked, &dead);
+                unsigned    hits = list_simd_bits(list_simd_clear(dead, list_simd_equal(data, target)));
+                if(hits != 0) {
+                    return slot + (size_t)__builtin_ctz(hits);
+                }
+            }
+            return scalar_t::find(list, value, slot, last, masked);
+        }
+
+        static size_t count(list_t *list, int value, size_t first, size_t last, bool masked) {
+            list_simd_t target = list_simd_set(value);
+            size_t      count  = 0;
+            size_t      slot   = first;
+            for(; slot + list_simd_lanes <= last + 1; slot += list_simd_lanes) {
+                list_simd_t dead = {};
+                list_simd_t data = block(list, slot, masked, &dead);
+                count += (size_t)__builtin_popcount(list_simd_bits(list_simd_clear(dead, list_simd_equal(data, target))));
+            }
+            return count + scalar_t::count(list, value, slot, last, masked);
+        }
+
+        template <typename sum_t>
+        static sum_t sum(list_t *list, size_t first, size_t last, bool masked) {
+            list_simd_t wide = list_simd_set(0);
+            size_t      slot = first;
+            for(; slot + list_simd_lanes <= last + 1; slot += list_simd_lanes) {
+                list_simd_t dead = {};
+                list_simd_t data = block(list, slot, masked, &dead);
+                wide = list_simd_widen_add(wide, list_simd_clear(dead, data));
+            }
+
+            long long lanes[list_simd_lanes / 2] = {};
+            memcpy(lanes, &wide, sizeof(wide));
+            long long sum = scalar_t::template sum<long long>(list, slot, last, masked);
+            for(size_t lane = 0; lane < list_simd_lanes / 2; lane++) {
+                sum += lanes[lane];
+            }
+            return (sum_t)sum;
+        }
+
+        /* Finds the extreme value, then its lowest slot with find. Lanes */
+        /* that never saw a live slot hold the neutral value, not a node. */
+        static size_t extreme(list_t *list, size_t first, size_t last, bool masked, bool maximum) {
+            list_simd_t neutral = list_simd_set(maximum ? INT_MIN : INT_MAX);
+            list_simd_t best    = neutral;
+            list_simd_t seen    = list_simd_set(0);
+            size_t      slot    = first;
+            for(; slot + list_simd_lanes <= last + 1; slot += list_simd_lanes) {
+                list_simd_t dead   = {};
+                list_simd_t data   = block(list, slot, masked, &dead);
+                data = list_simd_select(dead, neutral, data);
+                seen = list_simd_select(dead, seen, list_simd_set(-1));
+
+                list_simd_t better = maximum ? list_simd_above(data, best) : list_simd_above(best, data);
+                best = list_simd_select(better, data, best);
+            }
+
+            int lanes[list_simd_lanes] = {};
+            memcpy(lanes, &best, sizeof(best));
+            unsigned seen_lanes = list_simd_bits(seen);
+
+            size_t tail  = scalar_t::extreme(list, slot, last, masked, maximum);
+            bool   found = tail != 0;
+            int    value = found ? list->data_array[tail] : 0;
+            for(size_t lane = 0; lane < list_simd_lanes; lane++) {
+                if((seen_lanes >> lane & 1) == 0) {
+                    continue;
+                }
+                if(!found || (maximum ? lanes[lane] > value : lanes[lane] < value)) {
+                    value = lanes[lane];
+                    found = true;
+                }
+            }
+            return found ? find(list, value, first, last, masked) : 0;
+        }
+    };
+#endif
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_find(list_t *list, const typename list_t::elem_type &value, size_t *real_index) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    *real_index = list_scan_kernel_t<list_t>::find(list, value, 1, list_scan_last(list), !list->is_linear);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_count(list_t *list, const typename list_t::elem_type &value, size_t *count) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(count != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    *count = list_scan_kernel_t<list_t>::count(list, value, 1, list_scan_last(list), !list->is_linear);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename sum_t>
+list_error_t linked_list_sum(list_t *list, sum_t *sum) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(sum != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    *sum = list_scan_kernel_t<list_t>::template sum<sum_t>(list, 1, list_scan_last(list), !list->is_linear);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_min(list_t *list, size_t *real_index) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    *real_index = list_scan_kernel_t<list_t>::extreme(list, 1, list_scan_last(list), !list->is_linear, false);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_max(list_t *list, size_t *real_index) {
+    LINKED_LIST_VERIFY(list);
+    C_ASSERT(real_index != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    linked_list_compact       (list);
+    linked_list_poison_pending(list);
+    *real_index = list_scan_kernel_t<list_t>::extreme(list, 1, list_scan_last(list), !list->is_linear, true);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* A linear list keeps its nodes in slots 1..size. */
+template <typename list_t>
+size_t list_scan_last(list_t *list) {
+    return list->is_linear ? list->size : list->capacity;
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_SCAN(__prefix, __list_t)                                     \
+    __prefix template list_error_t linked_list_find <__list_t>(                              \
+        __list_t *, const __list_t::elem_type &, size_t *);                                  \
+    __prefix template list_error_t linked_list_count<__list_t>(                              \
+        __list_t *, const __list_t::elem_type &, size_t *);                                  \
+    __prefix template list_error_t linked_list_sum  <__list_t, long long>(                   \
+        __list_t *, long long *);                                                            \
+    __prefix template list_error_t linked_list_min  <__list_t>(__list_t *, size_t *);        \
+    __prefix template list_error_t linked_list_max  <__list_t>(__list_t *, size_t *);
+
+#endif
@@ -0,0 +1,336 @@
+#ifndef LINKED_LIST_SORT_H
+#define LINKED_LIST_SORT_H
+
+#include <limits.h>
+#include <algorithm>
+
+/*=======================================================================================*/
+
+/* Stable sort that relinks the chain: payloads stay in their slots and    */
+/* real indices stay valid. less is less(a, b) on payloads. Payloads that   */
+/* copy bytewise are sorted as (data, slot) pairs and linked in one pass,   */
+/* others, or all if the pairs do not fit, by a merge sort over the links.  */
+template <typename list_t, typename less_t>
+list_error_t linked_list_sort(list_t *list, less_t less);
+
+/* Sorts with operator<. Integer payloads are radix sorted instead: the */
+/* live values are gathered, sorted by bytes and written back to slots  */
+/* 1..size, which leaves the list linear and moves real indices.        */
+template <typename list_t>
+list_error_t linked_list_sort(list_t *list);
+
+template <typename list_t, typename less_t>
+list_error_t list_sort_relink(list_t *list,
+                              less_t &less);
+template <typename list_t, typename less_t>
+list_error_t list_sort_pairs(list_t *list,
+                             less_t &less);
+template <typename list_t, typename less_t>
+void         list_sort_links(list_t *list,
+                             less_t &less);
+template <typename list_t, typename less_t>
+size_t       list_sort_merge(list_t *list,
+                             size_t  left,
+                             size_t  right,
+                             less_t &less);
+template <typename list_t>
+list_error_t list_sort_by   (list_t *list,
+                             std::true_type);
+template <typename list_t>
+list_error_t list_sort_by   (list_t *list,
+                             std::false_type);
+template <typename list_t>
+list_error_t list_sort_radix(list_t *list);
+
+template <typename elem_t>
+struct list_sort_pair_t {
+    elem_t data;
+    size_t slot;
+};
+
+template <typename elem_t>
+struct list_sort_radix_t {
+    static const bool enabled = std::is_integral<elem_t>::value && !std::is_same<elem_t, bool>::value;
+};
+
+/*=======================================================================================*/
+
+/* The trace can not repeat a caller's comparator, see linked_list_trace.h. */
+template <typename list_t, typename less_t>
+list_error_t linked_list_sort(list_t *list, less_t less) {
+    list_error_t error_code = list_sort_relink(list, less);
+    if(error_code == LINKED_LIST_SUCCESS) {
+        LINKED_LIST_TRACE(list, LIST_TRACE_RELINK, 0, 0, 0);
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t, typename less_t>
+list_error_t list_sort_relink(list_t *list, less_t &less) {
+    LINKED_LIST_VERIFY(list);
+
+    typedef typename list_t::elem_type elem_t;
+
+    linked_list_compact(list);
+    if(!std::is_trivially_copyable<elem_t>::value || list_sort_pairs(list, less) != LINKED_LIST_SUCCESS) {
+        list_sort_links(list, less);
+    }
+
+    if(list->size > 1) {
+        list->is_linear = false;
+    }
+    if(list->order_index.tree != NULL) {
+        list_order_build(list);
+    }
+
+    LINKED_LIST_VERIFY_AFTER(list, 0);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t linked_list_sort(list_t *list) {
+    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+
+    typedef typename list_t::elem_type elem_t;
+
+    linked_list_compact(list);
+    list_error_t error_code = list_sort_by(list, std::integral_constant<bool, list_sort_radix_t<elem_t>::enabled>());
+    if(error_code == LINKED_LIST_SUCCESS) {
+        /* Linear after a radix sort into slots 1..size, relinked otherwise. */
+        LINKED_LIST_TRACE(list, LIST_TRACE_SORT, (size_t)list->is_linear, 0, 0);
+    }
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+/* Pairs are gathered in chain order, so stable_sort keeps equal payloads */
+/* in the order they had.                                                 */
+template <typename list_t, typename less_t>
+list_error_t list_sort_pairs(list_t *list, less_t &less) {
+    typedef typename list_t::elem_type  elem_t;
+    typedef typename list_t::index_type index_t;
+    typedef list_sort_pair_t<elem_t>    pair_t;
+
+    pair_t *pairs = (pair_t *)calloc(list->size + 1, sizeof(pair_t));
+    if(pairs == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    size_t pairs_number = 0;
+    for(size_t node = linked_list_next(list, 0); node != 0; node = linked_list_next(list, node)) {
+        memcpy((void *)&pairs[pairs_number].data, &linked_list_data(list, node), sizeof(elem_t));
+        pairs[pairs_number++].slot = node;
+    }
+
+    std::stable_sort(pairs, pairs + pairs_number, [&less](const pair_t &left, const pair_t &right) {
+        return less(left.data, right.data);
+    });
+
+    size_t prev = 0;
+    for(size_t pair = 0; pair < pairs_number; pair++) {
+        size_t node = pairs[pair].slot;
+        linked_list_next(list, prev) = (index_t)node;
+        linked_list_prev(list, node) = (index_t)prev;
+        prev = node;
+    }
+    linked_list_next(list, prev) = 0;
+    linked_list_prev(list, 0)    = (index_t)prev;
+
+    free(pairs);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Runs of 2^i nodes wait in bucket i, as in the classic in-place list */
+/* sort. The chain is taken off the zero element and ends at 0 meanwhile. */
+template <typename list_t, typename less_t>
+void list_sort_links(list_t *list, less_t &less) {
+    typedef typename list_t::index_type index_t;
+
+    static const size_t buckets_number = sizeof(size_t) * CHAR_BIT;
+
+    size_t buckets[buckets_number] = {};
+    size_t node = linked_list_next(list, 0);
+    linked_list_next(list, linked_list_prev(list, 0)) = 0;
+    while(node != 0) {
+        size_t carry = node;
+        node = linked_list_next(list, node);
+        linked_list_next(list, carry) = 0;
+
+        /* Older runs sit in higher buckets and go to the left of merges. */
+        size_t bucket = 0;
+        for(; buckets[bucket] != 0; bucket++) {
+            carry = list_sort_merge(list, buckets[bucket], carry, less);
+            buckets[bucket] = 0;
+        }
+        buckets[bucket] = carry;
+    }
+
+    size_t head = 0;
+    for(size_t bucket = 0; bucket < buckets_number; bucket++) {
+        if(buckets[bucket] != 0) {
+            head = list_sort_merge(list, buckets[bucket], head, less);
+        }
+    }
+
+    size_t prev = 0;
+    for(size_t current = head; current != 0; current = linked_list_next(list, current)) {
+        linked_list_prev(list, current) = (index_t)prev;
+        prev = current;
+    }
+    linked_list_next(list, prev) = 0;
+    linked_list_next(list, 0)    = (index_t)head;
+    linked_list_prev(list, 0)    = (index_t)prev;
+}
+
+/*=======================================================================================*/
+
+/* Merges two runs ending at 0, on ties the node from left goes first. */
+template <typename list_t, typename less_t>
+size_t list_sort_merge(list_t *list, size_t left, size_t right, less_t &less) {
+    typedef typename list_t::index_type index_t;
+
+    size_t head = 0;
+    size_t tail = 0;
+    while(left != 0 && right != 0) {
+        size_t taken = 0;
+        if(less(linked_list_data(list, right), linked_list_data(list, left))) {
+            taken = right;
+            right = linked_list_next(list, right);
+        }
+        else {
+            taken = left;
+            left  = linked_list_next(list, left);
+        }
+
+        if(tail == 0) {
+            head = taken;
+        }
+        else {
+            linked_list_next(list, tail) = (index_t)taken;
+        }
+        tail = taken;
+    }
+
+    size_t rest = left != 0 ? left : right;
+    if(tail == 0) {
+        return rest;
+    }
+    linked_list_next(list, tail) = (index_t)rest;
+    return head;
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t list_sort_by(list_t *list, std::true_type) {
+    LINKED_LIST_VERIFY(list);
+
+    if(list_sort_radix(list) == LINKED_LIST_SUCCESS) {
+        LINKED_LIST_VERIFY_AFTER(list, 0);
+        return LINKED_LIST_SUCCESS;
+    }
+    /* The radix buffers did not fit, merging needs no memory. */
+    return list_sort_by(list, std::false_type());
+}
+
+/*=======================================================================================*/
+
+template <typename list_t>
+list_error_t list_sort_by(list_t *list, std::false_type) {
+    typedef typename list_t::elem_type elem_t;
+
+    auto less = [](const elem_t &left, const elem_t &right) {
+        return left < right;
+    };
+    return list_sort_relink(list, less);
+}
+
+/*=======================================================================================*/
+
+/* LSD radix sort by bytes, the sign bit is flipped so negative values go */
+/* first. Passes where every value has the same byte are skipped.         */
+template <typename list_t>
+list_error_t list_sort_radix(list_t *list) {
+    typedef typename list_t::elem_type                elem_t;
+    typedef typename list_t::index_type               index_t;
+    typedef typename std::make_unsigned<elem_t>::type radix_key_t;
+
+    static const size_t      digits_number = sizeof(elem_t);
+    static const size_t      digit_values  = 1 << CHAR_BIT;
+    static const radix_key_t sign_flip     = std::is_signed<elem_t>::value ?
+                                             (radix_key_t)((radix_key_t)1 << (sizeof(radix_key_t) * CHAR_BIT - 1)) : 0;
+
+    const index_t poison = list_index_traits_t<index_t>::poison;
+
+    size_t       size   = list->size;
+    radix_key_t *keys   = (radix_key_t *)calloc(size + 1, sizeof(radix_key_t));
+    radix_key_t *buffer = (radix_key_t *)calloc(size + 1, sizeof(radix_key_t));
+    size_t      *counts = (size_t      *)calloc(digits_number * digit_values, sizeof(size_t));
+    if(keys == NULL || buffer == NULL || counts == NULL) {
+        free(keys);
+        free(buffer);
+        free(counts);
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    linked_list_poison_pending(list);
+
+    /* Order does not matter here, so the array is read front to back. */
+    size_t gathered = 0;
+    size_t last     = list_scan_last(list);
+    for(size_t slot = 1; slot <= last; slot++) {
+        if(linked_list_prev(list, slot) != poison) {
+            radix_key_t key = (radix_key_t)((radix_key_t)linked_list_data(list, slot) ^ sign_flip);
+            keys[gathered++] = key;
+            for(size_t digit = 0; digit < digits_number; digit++) {
+                counts[digit * digit_values + (key >> (digit * CHAR_BIT) & (digit_values - 1))]++;
+            }
+        }
+    }
+
+    for(size_t digit = 0; digit < digits_number && size != 0; digit++) {
+        size_t *count = counts + digit * digit_values;
+        size_t  shift = digit * CHAR_BIT;
+        if(count[keys[0] >> shift & (digit_values - 1)] == size) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for(size_t value = 0; value < digit_values; value++) {
+            size_t number = count[value];
+            count[value]  = offset;
+            offset       += number;
+        }
+        for(size_t key = 0; key < size; key++) {
+            buffer[count[keys[key] >> shift & (digit_values - 1)]++] = keys[key];
+        }
+        std::swap(keys, buffer);
+    }
+
+    for(size_t slot = 1; slot <= size; slot++) {
+        linked_list_data(list, slot) = (elem_t)(keys[slot - 1] ^ sign_flip);
+    }
+    for(size_t slot = size + 1; slot <= list->capacity; slot++) {
+        linked_list_data(list, slot) = list_data_traits_t<elem_t>::poison();
+    }
+    list_link_linear(list);
+
+    free(keys);
+    free(buffer);
+    free(counts);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+#define LINKED_LIST_INSTANTIATE_SORT(__prefix, __list_t)                                     \
+    __prefix template list_error_t linked_list_sort<__list_t>(__list_t *);
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef LINKED_LIST_STATS_H
+#define LINKED_LIST_STATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+
+/*=======================================================================================*/
+
+/* Counters every list keeps unless LINKED_LIST_OFF_STATS is defined. The */
+/* operations only add to them, linked_list_get_stats fills in the rest.  */
+struct list_stats_t {
+    size_t inserts;           /* nodes linked in, ranges count every node   */
+    size_t removes;           /* nodes unlinked, clear counts the old size  */
+    size_t compactions;       /* tombstone sweeps of linked_list_compact    */
+    size_t free_pops;         /* slots taken off the free list              */
+    size_t reallocations;     /* array resizes, growth and reserve/shrink   */
+    size_t reallocated_bytes; /* bytes the resizes carried over             */
+    size_t verify_calls;      /* whole list checks                          */
+    size_t verify_ns;
+    size_t dump_calls;
+    size_t dump_ns;
+    size_t peak_size;
+    /* Filled in by linked_list_get_stats. */
+    size_t size;
+    size_t capacity;
+    double fragmentation;     /* share of chain links to a non-next slot    */
+};
+
+enum list_stats_format_t {
+    LINKED_LIST_STATS_TEXT = 0,
+    LINKED_LIST_STATS_JSON = 1,
+};
+
+/* Writes the stats as aligned text lines or one JSON object. */
+void list_stats_write(const list_stats_t *stats, FILE *file, list_stats_format_t format);
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_STATS
+    #define LINKED_LIST_STATS_ADD(__list, __counter, __amount)                              \
+        ((__list)->stats.__counter += (__amount))
+    #define LINKED_LIST_STATS_PEAK(__list)                                                  \
+        if((__list)->size > (__list)->stats.peak_size) {                                    \
+            (__list)->stats.peak_size = (__list)->size;                                     \
+        }
+    /* Counts a call of the enclosing function and its time till return. */
+    #define LINKED_LIST_STATS_TIME(__list, __calls, __ns)                                   \
+        (__list)->stats.__calls++;                                                          \
+        list_stats_timer_t __stats_timer(&(__list)->stats.__ns)
+
+    struct list_stats_timer_t {
+        size_t                                *output;
+        std::chrono::steady_clock::time_point  start;
+
+        explicit list_stats_timer_t(size_t *output_ns)
+            : output(output_ns), start(std::chrono::steady_clock::now()) {}
+        ~list_stats_timer_t() {
+            *output += (size_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start).count();
+        }
+
+        list_stats_timer_t(const list_stats_timer_t &)            = delete;
+        list_stats_timer_t &operator=(const list_stats_timer_t &) = delete;
+    };
+#else
+    #define LINKED_LIST_STATS_ADD(...)
+    #define LINKED_LIST_STATS_PEAK(...)
+    #define LINKED_LIST_STATS_TIME(...)
+#endif
+
+#endif
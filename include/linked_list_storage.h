@@ -0,0 +1,403 @@
+#ifndef LINKED_LIST_STORAGE_H
+#define LINKED_LIST_STORAGE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t = size_t>
+struct basic_list_node_t {
+    elem_t  data;
+    index_t prev;
+    index_t next;
+};
+
+/*=======================================================================================*/
+
+/* Array of structures: payload and both links of a slot share one node. */
+template <typename elem_t, typename index_t>
+struct list_aos_storage_t {
+    basic_list_node_t<elem_t, index_t> *array;
+};
+
+/* Structure of arrays: payloads, prev links and next links are three arrays */
+/* carved out of one block, so a walk over one of them streams only it.       */
+template <typename elem_t, typename index_t>
+struct list_soa_storage_t {
+    elem_t  *data_array;
+    index_t *prev_array;
+    index_t *next_array;
+};
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+inline elem_t  &linked_list_data(list_aos_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->array[node].data;
+}
+
+template <typename elem_t, typename index_t>
+inline index_t &linked_list_prev(list_aos_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->array[node].prev;
+}
+
+template <typename elem_t, typename index_t>
+inline index_t &linked_list_next(list_aos_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->array[node].next;
+}
+
+template <typename elem_t, typename index_t>
+inline elem_t  &linked_list_data(list_soa_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->data_array[node];
+}
+
+template <typename elem_t, typename index_t>
+inline index_t &linked_list_prev(list_soa_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->prev_array[node];
+}
+
+template <typename elem_t, typename index_t>
+inline index_t &linked_list_next(list_soa_storage_t<elem_t, index_t> *storage, size_t node) {
+    return storage->next_array[node];
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+inline const void *list_storage_block(list_aos_storage_t<elem_t, index_t> *storage) {
+    return storage->array;
+}
+
+template <typename elem_t, typename index_t>
+inline const void *list_storage_block(list_soa_storage_t<elem_t, index_t> *storage) {
+    return storage->data_array;
+}
+
+/*=======================================================================================*/
+
+/* Memory hooks of a list. reallocate may be NULL, then blocks are moved */
+/* through allocate and free. Sizes passed to free and reallocate are the */
+/* ones the block was obtained with.                                      */
+struct list_allocator_t {
+    void *(*allocate)  (void *context, size_t size);
+    void *(*reallocate)(void *context, void *block, size_t old_size, size_t new_size);
+    void  (*free)      (void *context, void *block, size_t size);
+    void   *context;
+};
+
+/*=======================================================================================*/
+
+/* Raw blocks of the storages, type independent part lives in linked_list.cpp. */
+/* With a NULL allocator, blocks of at least list_block_map_threshold bytes    */
+/* are mapped directly where mremap exists, so growing them remaps pages       */
+/* instead of copying them, smaller ones come from calloc and realloc.         */
+/* New blocks are zero filled, bytes a resize adds are left unspecified.        */
+static const size_t list_block_map_threshold = (size_t)1 << 22;
+
+void *list_block_allocate(const list_allocator_t *allocator, size_t size);
+void *list_block_resize  (const list_allocator_t *allocator,
+                          void                   *block,
+                          size_t                  old_size,
+                          size_t                  new_size);
+void  list_block_free    (const list_allocator_t *allocator, void *block, size_t size);
+
+/*=======================================================================================*/
+
+/* Slot counts whose block size would not fit in ptrdiff_t are refused. */
+template <typename elem_t, typename index_t>
+bool list_storage_fits(size_t count) {
+    return count <= (size_t)PTRDIFF_MAX / (sizeof(basic_list_node_t<elem_t, index_t>) + alignof(index_t));
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t>
+void list_construct_slots(elem_t *first, size_t count) {
+    if(!std::is_trivially_default_constructible<elem_t>::value) {
+        for(size_t slot = 0; slot < count; slot++) {
+            new (first + slot) elem_t();
+        }
+    }
+}
+
+template <typename elem_t>
+void list_destroy_slots(elem_t *first, size_t count) {
+    if(!std::is_trivially_destructible<elem_t>::value) {
+        for(size_t slot = 0; slot < count; slot++) {
+            first[slot].~elem_t();
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+/* Memory of the storages. Slots are always zero filled and hold constructed   */
+/* payloads, payloads that can not be copied bytewise are moved one by one.    */
+template <typename elem_t, typename index_t>
+list_error_t list_storage_allocate(list_aos_storage_t<elem_t, index_t> *storage,
+                                   size_t                               count,
+                                   const list_allocator_t              *allocator) {
+    typedef basic_list_node_t<elem_t, index_t> node_t;
+
+    if(!list_storage_fits<elem_t, index_t>(count)) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    storage->array = (node_t *)list_block_allocate(allocator, count * sizeof(node_t));
+    if(storage->array == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    for(size_t node = 0; node < count; node++) {
+        list_construct_slots(&storage->array[node].data, 1);
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+list_error_t list_storage_resize(list_aos_storage_t<elem_t, index_t> *storage,
+                                 size_t                               old_count,
+                                 size_t                               new_count,
+                                 const list_allocator_t              *allocator) {
+    typedef basic_list_node_t<elem_t, index_t> node_t;
+
+    if(!list_storage_fits<elem_t, index_t>(new_count)) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    if(std::is_trivially_copyable<elem_t>::value) {
+        node_t *new_array = (node_t *)list_block_resize(allocator,
+                                                        (void *)storage->array,
+                                                        old_count * sizeof(node_t),
+                                                        new_count * sizeof(node_t));
+        if(new_array == NULL) {
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+        storage->array = new_array;
+
+        if(new_count > old_count) {
+            memset((void *)(storage->array + old_count), 0, (new_count - old_count) * sizeof(node_t));
+        }
+        return LINKED_LIST_SUCCESS;
+    }
+
+    node_t *new_array = (node_t *)list_block_allocate(allocator, new_count * sizeof(node_t));
+    if(new_array == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    size_t kept_count = old_count < new_count ? old_count : new_count;
+    for(size_t node = 0; node < kept_count; node++) {
+        new (&new_array[node].data) elem_t(std::move(storage->array[node].data));
+        new_array[node].prev = storage->array[node].prev;
+        new_array[node].next = storage->array[node].next;
+    }
+    for(size_t node = kept_count; node < new_count; node++) {
+        list_construct_slots(&new_array[node].data, 1);
+    }
+    for(size_t node = 0; node < old_count; node++) {
+        list_destroy_slots(&storage->array[node].data, 1);
+    }
+
+    list_block_free(allocator, storage->array, old_count * sizeof(node_t));
+    storage->array = new_array;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+void list_storage_free(list_aos_storage_t<elem_t, index_t> *storage,
+                       size_t                               count,
+                       const list_allocator_t              *allocator) {
+    if(storage->array == NULL) {
+        return;
+    }
+
+    for(size_t node = 0; node < count; node++) {
+        list_destroy_slots(&storage->array[node].data, 1);
+    }
+    list_block_free(allocator, storage->array, count * sizeof(basic_list_node_t<elem_t, index_t>));
+    storage->array = NULL;
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+size_t list_soa_links_offset(size_t count) {
+    size_t offset = count * sizeof(elem_t);
+    return (offset + alignof(index_t) - 1) / alignof(index_t) * alignof(index_t);
+}
+
+template <typename elem_t, typename index_t>
+size_t list_soa_block_size(size_t count) {
+    return list_soa_links_offset<elem_t, index_t>(count) + 2 * count * sizeof(index_t);
+}
+
+template <typename elem_t, typename index_t>
+void list_soa_carve(list_soa_storage_t<elem_t, index_t> *storage, void *block, size_t count) {
+    storage->data_array = (elem_t *)block;
+    storage->prev_array = (index_t *)((char *)block + list_soa_links_offset<elem_t, index_t>(count));
+    storage->next_array = storage->prev_array + count;
+}
+
+/*=======================================================================================*/
+
+/* Layout tag, block size and attaching an existing block, for backends */
+/* that keep the storage block outside of the process.                 */
+template <typename elem_t, typename index_t>
+inline size_t list_storage_layout(list_aos_storage_t<elem_t, index_t> *) {
+    return 0;
+}
+
+template <typename elem_t, typename index_t>
+inline size_t list_storage_layout(list_soa_storage_t<elem_t, index_t> *) {
+    return 1;
+}
+
+template <typename elem_t, typename index_t>
+inline size_t list_storage_size(list_aos_storage_t<elem_t, index_t> *, size_t count) {
+    return count * sizeof(basic_list_node_t<elem_t, index_t>);
+}
+
+template <typename elem_t, typename index_t>
+inline size_t list_storage_size(list_soa_storage_t<elem_t, index_t> *, size_t count) {
+    return list_soa_block_size<elem_t, index_t>(count);
+}
+
+template <typename elem_t, typename index_t>
+inline void list_storage_attach(list_aos_storage_t<elem_t, index_t> *storage, void *block, size_t) {
+    storage->array = (basic_list_node_t<elem_t, index_t> *)block;
+}
+
+template <typename elem_t, typename index_t>
+inline void list_storage_attach(list_soa_storage_t<elem_t, index_t> *storage, void *block, size_t count) {
+    list_soa_carve(storage, block, count);
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+list_error_t list_storage_allocate(list_soa_storage_t<elem_t, index_t> *storage,
+                                   size_t                               count,
+                                   const list_allocator_t              *allocator) {
+    if(!list_storage_fits<elem_t, index_t>(count)) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    void *block = list_block_allocate(allocator, list_soa_block_size<elem_t, index_t>(count));
+    if(block == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    list_soa_carve(storage, block, count);
+    list_construct_slots(storage->data_array, count);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+list_error_t list_storage_resize(list_soa_storage_t<elem_t, index_t> *storage,
+                                 size_t                               old_count,
+                                 size_t                               new_count,
+                                 const list_allocator_t              *allocator) {
+    if(!list_storage_fits<elem_t, index_t>(new_count)) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    size_t old_size = list_soa_block_size<elem_t, index_t>(old_count);
+    size_t new_size = list_soa_block_size<elem_t, index_t>(new_count);
+
+    if(std::is_trivially_copyable<elem_t>::value && new_count >= old_count) {
+        void *block = list_block_resize(allocator, (void *)storage->data_array, old_size, new_size);
+        if(block == NULL) {
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+
+        /* Link arrays move up to their new offsets, the higher one first. */
+        list_soa_storage_t<elem_t, index_t> old_storage = {};
+        list_soa_carve(&old_storage, block, old_count);
+        list_soa_carve(storage,      block, new_count);
+
+        memmove(storage->next_array, old_storage.next_array, old_count * sizeof(index_t));
+        memmove(storage->prev_array, old_storage.prev_array, old_count * sizeof(index_t));
+
+        memset((void *)(storage->data_array + old_count), 0, (new_count - old_count) * sizeof(elem_t));
+        memset(storage->prev_array + old_count, 0, (new_count - old_count) * sizeof(index_t));
+        memset(storage->next_array + old_count, 0, (new_count - old_count) * sizeof(index_t));
+        return LINKED_LIST_SUCCESS;
+    }
+
+    if(std::is_trivially_copyable<elem_t>::value) {
+        /* Shrinking moves the link arrays down, the lower one first, and */
+        /* releases the tail in place. Only free slots are released, so   */
+        /* if that fails they are chained again as the free tail.         */
+        list_soa_storage_t<elem_t, index_t> new_storage = {};
+        list_soa_carve(&new_storage, storage->data_array, new_count);
+
+        memmove(new_storage.prev_array, storage->prev_array, new_count * sizeof(index_t));
+        memmove(new_storage.next_array, storage->next_array, new_count * sizeof(index_t));
+
+        void *block = list_block_resize(allocator, (void *)storage->data_array, old_size, new_size);
+        if(block == NULL) {
+            memmove(storage->next_array, new_storage.next_array, new_count * sizeof(index_t));
+            memmove(storage->prev_array, new_storage.prev_array, new_count * sizeof(index_t));
+            for(size_t node = new_count; node < old_count; node++) {
+                storage->prev_array[node] = list_index_traits_t<index_t>::poison;
+                storage->next_array[node] = (index_t)(node + 1);
+            }
+            return LINKED_LIST_MEMORY_ERROR;
+        }
+
+        list_soa_carve(storage, block, new_count);
+        return LINKED_LIST_SUCCESS;
+    }
+
+    void *block = list_block_allocate(allocator, new_size);
+    if(block == NULL) {
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+
+    list_soa_storage_t<elem_t, index_t> new_storage = {};
+    list_soa_carve(&new_storage, block, new_count);
+
+    size_t kept_count = old_count < new_count ? old_count : new_count;
+    for(size_t node = 0; node < kept_count; node++) {
+        new (new_storage.data_array + node) elem_t(std::move(storage->data_array[node]));
+    }
+    list_construct_slots(new_storage.data_array + kept_count, new_count - kept_count);
+    memcpy(new_storage.prev_array, storage->prev_array, kept_count * sizeof(index_t));
+    memcpy(new_storage.next_array, storage->next_array, kept_count * sizeof(index_t));
+
+    list_destroy_slots(storage->data_array, old_count);
+    list_block_free(allocator, storage->data_array, old_size);
+    *storage = new_storage;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+template <typename elem_t, typename index_t>
+void list_storage_free(list_soa_storage_t<elem_t, index_t> *storage,
+                       size_t                               count,
+                       const list_allocator_t              *allocator) {
+    if(storage->data_array == NULL) {
+        return;
+    }
+
+    list_destroy_slots(storage->data_array, count);
+    list_block_free(allocator, storage->data_array, list_soa_block_size<elem_t, index_t>(count));
+    storage->data_array = NULL;
+    storage->prev_array = NULL;
+    storage->next_array = NULL;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef LINKED_LIST_TOMBSTONES_H
+#define LINKED_LIST_TOMBSTONES_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/*=======================================================================================*/
+
+/* Nodes removed in deferred mode, see linked_list_set_deferred_remove. Bit */
+/* s is set while slot s is a tombstone: still chained, payload moved out.  */
+/* words is NULL while the mode is off.                                     */
+struct list_tombstones_t {
+    uint64_t *words;
+    size_t    words_number;
+    size_t    number;
+    size_t    compact_percent;
+};
+
+/*=======================================================================================*/
+
+/* Resizes to hold bits_number bits, new bits are clear. */
+list_error_t list_tombstones_resize(list_tombstones_t *tombstones,
+                                    size_t             bits_number);
+void         list_tombstones_free  (list_tombstones_t *tombstones);
+
+/*=======================================================================================*/
+
+/* A load of number is all a list without tombstones pays per node. */
+inline bool list_tombstones_test(const list_tombstones_t *tombstones, size_t slot) {
+    return tombstones->number != 0 && (tombstones->words[slot >> 6] >> (slot & 63) & 1) != 0;
+}
+
+/*=======================================================================================*/
+
+inline void list_tombstones_set(list_tombstones_t *tombstones, size_t slot) {
+    tombstones->words[slot >> 6] |= 1ull << (slot & 63);
+    tombstones->number++;
+}
+
+#endif
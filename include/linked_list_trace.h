@@ -0,0 +1,131 @@
+#ifndef LINKED_LIST_TRACE_H
+#define LINKED_LIST_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <type_traits>
+
+/*=======================================================================================*/
+
+/* Operation trace: while linked_list_trace_start is in effect, every    */
+/* operation that adds, removes or moves nodes of a list built after the */
+/* start is appended to one binary file. Lists built earlier or opened   */
+/* from an existing file, pools and concurrent lists are not recorded.   */
+/* bench_replay runs a trace again.                                      */
+/* The hooks compile out with LINKED_LIST_OFF_TRACE.                     */
+/*                                                                       */
+/* The file is list_trace_magic followed by records: an op byte, the     */
+/* list id as a varint and the arguments of the op as varints, signed    */
+/* values zigzag coded. Inserts store the slot they got, so a replay     */
+/* maps recorded real indices to its own and does not depend on the      */
+/* free-slot policy of the library that recorded them. Linearize, shrink */
+/* and radix sort leave position p in slot p + 1 in both lists, so the   */
+/* map starts over from there.                                           */
+/*                                                                       */
+/* A sort with a caller's comparator can not be repeated, it is recorded */
+/* as LIST_TRACE_RELINK and bench_replay refuses the trace. Deferred     */
+/* removal is replayed as plain removal.                                 */
+enum list_trace_op_t {
+    LIST_TRACE_CTOR                = 1,  /* index = capacity                      */
+    LIST_TRACE_INSERT_AFTER        = 2,  /* index = anchor, slot, value           */
+    LIST_TRACE_INSERT_BEFORE       = 3,  /* index = anchor, slot, value           */
+    LIST_TRACE_REMOVE              = 4,  /* index = removed slot                  */
+    LIST_TRACE_DTOR                = 5,
+    LIST_TRACE_INSERT_RANGE_AFTER  = 6,  /* index = anchor, value = nodes number  */
+    LIST_TRACE_INSERT_RANGE_BEFORE = 7,  /* index = anchor, value = nodes number  */
+    LIST_TRACE_RANGE_NODE          = 8,  /* slot, value of the next range node    */
+    LIST_TRACE_REMOVE_RANGE        = 9,  /* index = first, slot = last            */
+    LIST_TRACE_CLEAR               = 10,
+    LIST_TRACE_LINEARIZE           = 11,
+    LIST_TRACE_SHRINK              = 12,
+    LIST_TRACE_SORT                = 13, /* index = 1 if slots were renumbered    */
+    LIST_TRACE_RELINK              = 14, /* comparator sort, not replayable       */
+};
+
+struct list_trace_record_t {
+    list_trace_op_t op;
+    size_t          list;
+    size_t          index;
+    size_t          slot;
+    int64_t         value;
+};
+
+static const char   list_trace_magic[]    = "LLTRACE2";
+static const size_t list_trace_magic_size = sizeof(list_trace_magic) - 1;
+
+/* Set while a trace is open, the hooks test it before anything else. */
+extern std::atomic<bool> list_trace_running;
+
+list_error_t linked_list_trace_start(const char                *path);
+list_error_t linked_list_trace_stop (void);
+
+/* Id for a new list, 0 while no trace is open. */
+size_t       list_trace_new_id      (void);
+void         list_trace_write       (const list_trace_record_t *record);
+/* Whether records of op carry index, slot and value, false for unknown ops. */
+bool         list_trace_fields      (list_trace_op_t            op,
+                                     bool                      *has_index,
+                                     bool                      *has_slot,
+                                     bool                      *has_value);
+/* Decodes the record at *cursor and moves it past the record. */
+list_error_t list_trace_read        (const uint8_t            **cursor,
+                                     const uint8_t             *end,
+                                     list_trace_record_t       *record);
+
+/*=======================================================================================*/
+
+/* Payloads are recorded as integers, others as 0. */
+template <typename elem_t>
+int64_t list_trace_value(const elem_t &data, std::true_type) {
+    return (int64_t)data;
+}
+
+template <typename elem_t>
+int64_t list_trace_value(const elem_t &, std::false_type) {
+    return 0;
+}
+
+template <typename elem_t>
+int64_t list_trace_value(const elem_t &data) {
+    return list_trace_value(data, std::is_integral<elem_t>());
+}
+
+/*=======================================================================================*/
+
+#ifndef LINKED_LIST_OFF_TRACE
+    #define LINKED_LIST_TRACE(__list, __op, __index, __slot, __value)                       \
+        if(list_trace_running.load(std::memory_order_relaxed) && (__list)->trace_id != 0) { \
+            list_trace_record_t __record = {(__op), (__list)->trace_id,                    \
+                                            (__index), (__slot), (__value)};                \
+            list_trace_write(&__record);                                                    \
+        }
+    #define LINKED_LIST_TRACE_INSERT(__list, __op, __anchor, __slot)                        \
+        LINKED_LIST_TRACE((__list), (__op), (__anchor), (__slot),                           \
+                          list_trace_value(linked_list_data((__list), (__slot))))
+    #define LINKED_LIST_TRACE_RANGE(__list, __op, __anchor, __first, __number)              \
+        if(list_trace_running.load(std::memory_order_relaxed) && (__list)->trace_id != 0) { \
+            list_trace_range((__list), (__op), (__anchor), (__first), (__number));          \
+        }
+
+    /* The header record, then one LIST_TRACE_RANGE_NODE per node in order. */
+    template <typename list_t>
+    void list_trace_range(list_t *list, list_trace_op_t op, size_t anchor, size_t first, size_t number) {
+        list_trace_record_t record = {op, list->trace_id, anchor, 0, (int64_t)number};
+        list_trace_write(&record);
+
+        size_t node = first;
+        for(size_t written = 0; written < number; written++) {
+            record = {LIST_TRACE_RANGE_NODE, list->trace_id, 0, node,
+                      list_trace_value(linked_list_data(list, node))};
+            list_trace_write(&record);
+            node = linked_list_next(list, node);
+        }
+    }
+#else
+    #define LINKED_LIST_TRACE(...)
+    #define LINKED_LIST_TRACE_INSERT(...)
+    #define LINKED_LIST_TRACE_RANGE(...)
+#endif
+
+#endif
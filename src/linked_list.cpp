@@ -1,10 +1,29 @@
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 
 #include "custom_assert.h"
 #include "colors.h"
 #include "linked_list.h"
 
+#ifndef LINKED_LIST_OFF_DUMP
+    #include <thread>
+    #include <mutex>
+    #include <condition_variable>
+#endif
+
+#if defined(__linux__) && !defined(LINKED_LIST_OFF_MREMAP)
+    #include <sys/mman.h>
+    #define LINKED_LIST_MAPPED_BLOCKS
+#endif
+
+static size_t list_free_bits_after (const list_free_bits_t *bits,
+                                    size_t                  level,
+                                    size_t                  position);
+static size_t list_free_bits_before(const list_free_bits_t *bits,
+                                    size_t                  level,
+                                    size_t                  position);
+
 /*=======================================================================================*/
 
 #ifndef LINKED_LIST_OFF_DUMP
@@ -12,223 +31,362 @@
     static const char   *log_folder                = "log";
     static const char   *dump_dot_file_folder      = "dot";
     static const char   *dump_png_file_folder      = "img";
-    static const size_t  max_file_name_length      = 64;
     static const size_t  max_system_command_length = 256;
-    static const char   *zero_color                = "#bfecff";
-    static const char   *head_color                = "#cdc1ff";
-    static const char   *tail_color                = "#ffccea";
-    static const char   *elem_color                = "#fff6e3";
-    static const char   *free_color                = "#c1cfa1";
+    /* One graphviz call renders as many queued dumps as fit in the command. */
+    static const size_t  max_batch_command_length  = 4096;
+    /* Dot text is flushed to the file in blocks of this size. */
+    static const size_t  dump_writer_buffer_size   = 1 << 20;
+    static const size_t  max_dump_line_length      = 512;
+
+    /* Background dump worker, see linked_list_dump_start_worker. */
+    static std::mutex               dump_mutex;
+    static std::condition_variable  dump_queue_filled;
+    static std::condition_variable  dump_queue_drained;
+    static std::thread              dump_worker;
+    static list_dump_job_t         *dump_queue_head      = NULL;
+    static list_dump_job_t         *dump_queue_tail      = NULL;
+    static bool                     dump_worker_started  = false;
+    static bool                     dump_worker_stopping = false;
+    static bool                     dump_worker_busy     = false;
+
+    static void         linked_list_dump_worker     (void);
+    static void         linked_list_dump_batch      (list_dump_job_t *batch);
+    static void         linked_list_dump_at_exit    (void);
+    static list_error_t linked_list_write_dump_entry(FILE       *general_dump_file,
+                                                     const char *img_filename,
+                                                     const char *caller_file,
+                                                     size_t      caller_line,
+                                                     const char *caller_function,
+                                                     const char *list_variable_name,
+                                                     const char *header,
+                                                     const void *list,
+                                                     size_t      capacity,
+                                                     size_t      free,
+                                                     const void *array,
+                                                     const list_dump_stats_t *stats);
+#endif
 
-    /*=======================================================================================*/
+/*=======================================================================================*/
 
-    static const char  *linked_list_element_color          (linked_list_t *list,
-                                                            size_t         node);
-    static list_error_t linked_list_create_png_dump        (linked_list_t *list,
-                                                            const char    *png_filename,
-                                                            const char    *dot_filename,
-                                                            const char    *caller_file,
-                                                            size_t         caller_line,
-                                                            const char    *caller_function,
-                                                            const char    *list_variable_name,
-                                                            const char    *header);
-    static list_error_t linked_list_create_dot_dump        (linked_list_t *list,
-                                                            const char    *filename);
-    static list_error_t linked_list_write_node_connections (linked_list_t *list,
-                                                            FILE          *dot_file);
-    static list_error_t linked_list_initialize_dump        (linked_list_t *list);
-
-    static list_error_t linked_list_write_nodes            (linked_list_t *list,
-                                                            FILE          *dot_file);
-#endif
+LINKED_LIST_INSTANTIATE(, linked_list_t)
+LINKED_LIST_INSTANTIATE(, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_POOLED(, pooled_linked_list_t)
+LINKED_LIST_INSTANTIATE_CONCURRENT(, concurrent_linked_list_t)
+LINKED_LIST_INSTANTIATE_QUEUE(, list_queue_t)
+LINKED_LIST_INSTANTIATE_PARALLEL(, linked_list_t)
+LINKED_LIST_INSTANTIATE_PARALLEL(, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_SCAN(, linked_list_t)
+LINKED_LIST_INSTANTIATE_SCAN(, soa_linked_list_t)
+LINKED_LIST_INSTANTIATE_SORT(, linked_list_t)
+LINKED_LIST_INSTANTIATE_SORT(, soa_linked_list_t)
 
 /*=======================================================================================*/
 
-#ifndef LINKED_LIST_OFF_VERIFICATION
-    #define LINKED_LIST_VERIFY(__list)  {                         \
-        list_error_t __error_code = linked_list_verify((__list)); \
-        if(__error_code != LINKED_LIST_SUCCESS) {                 \
-            return __error_code;                                  \
-        }                                                         \
+size_t list_grow_geometric(size_t capacity, size_t percent) {
+    size_t extra = percent > 100 ? percent - 100 : 0;
+    if(capacity != 0 && extra > SIZE_MAX / capacity) {
+        return SIZE_MAX;
     }
+    return capacity + capacity * extra / 100;
+}
 
-    /*=======================================================================================*/
+/*=======================================================================================*/
 
-    static list_error_t linked_list_verify(linked_list_t *list);
-#else
-    #define LINKED_LIST_VERIFY(...)
-#endif
+size_t list_grow_additive(size_t capacity, size_t step) {
+    return capacity + step;
+}
 
 /*=======================================================================================*/
 
-static list_error_t linked_list_find_free      (linked_list_t *list,
-                                                size_t        *output);
-static list_error_t linked_list_insert_between (linked_list_t *list,
-                                                size_t         prev_node,
-                                                size_t         next_node,
-                                                data_t         data);
-static size_t       linked_list_get_head       (linked_list_t *list);
-static size_t       linked_list_get_tail       (linked_list_t *list);
-static list_error_t list_reallocate_memory     (linked_list_t *list);
-static list_error_t linked_list_set_default    (linked_list_t *list,
-                                                size_t         start,
-                                                size_t         end);
+void *list_block_allocate(const list_allocator_t *allocator, size_t size) {
+    if(allocator != NULL) {
+        void *block = allocator->allocate(allocator->context, size);
+        if(block != NULL) {
+            memset(block, 0, size);
+        }
+        return block;
+    }
+
+    #ifdef LINKED_LIST_MAPPED_BLOCKS
+        if(size >= list_block_map_threshold) {
+            void *block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            return block == MAP_FAILED ? NULL : block;
+        }
+    #endif
+    return calloc(1, size);
+}
 
 /*=======================================================================================*/
 
-list_error_t linked_list_ctor(linked_list_t *list, size_t capacity) {
-    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+void *list_block_resize(const list_allocator_t *allocator,
+                        void                   *block,
+                        size_t                  old_size,
+                        size_t                  new_size) {
+    if(allocator != NULL && allocator->reallocate != NULL) {
+        return allocator->reallocate(allocator->context, block, old_size, new_size);
+    }
 
-    list_error_t error_code = LINKED_LIST_SUCCESS;
+    bool moves_by_copy = allocator != NULL;
 
-    list->array = (list_node_t *)calloc(capacity + 1, sizeof(list_node_t));
-    if(list->array == NULL) {
-        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
-                     "Error while allocating data memory.\r\n");
-        return LINKED_LIST_MEMORY_ERROR;
-    }
+    #ifdef LINKED_LIST_MAPPED_BLOCKS
+        if(allocator == NULL) {
+            bool old_mapped = old_size >= list_block_map_threshold;
+            bool new_mapped = new_size >= list_block_map_threshold;
 
-    list->array->next = 0;
-    list->array->prev = 0;
-    list->array->data = 211;
-    list->free        = 1;
-    list->capacity    = capacity;
-    list->size        = 0;
+            if(old_mapped && new_mapped) {
+                void *new_block = mremap(block, old_size, new_size, MREMAP_MAYMOVE);
+                return new_block == MAP_FAILED ? NULL : new_block;
+            }
+            moves_by_copy = old_mapped || new_mapped;
+        }
+    #endif
 
-    if((error_code = linked_list_set_default(list,
-                                             1,
-                                             capacity + 1)) != LINKED_LIST_SUCCESS) {
-        return error_code;
+    if(moves_by_copy) {
+        void *new_block = list_block_allocate(allocator, new_size);
+        if(new_block == NULL) {
+            return NULL;
+        }
+        memcpy(new_block, block, old_size < new_size ? old_size : new_size);
+        list_block_free(allocator, block, old_size);
+        return new_block;
     }
+    return realloc(block, new_size);
+}
 
+/*=======================================================================================*/
 
-    if((error_code = linked_list_initialize_dump(list)) != LINKED_LIST_SUCCESS) {
-        return error_code;
+void list_block_free(const list_allocator_t *allocator, void *block, size_t size) {
+    if(allocator != NULL) {
+        allocator->free(allocator->context, block, size);
+        return;
     }
 
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
+    #ifdef LINKED_LIST_MAPPED_BLOCKS
+        if(size >= list_block_map_threshold) {
+            munmap(block, size);
+            return;
+        }
+    #endif
+    free(block);
 }
 
 /*=======================================================================================*/
 
-list_error_t linked_list_insert_after(linked_list_t *list, size_t real_index, data_t data) {
-    LINKED_LIST_VERIFY(list);
-    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+size_t list_parallel_threads(size_t threads_number) {
+    if(threads_number != 0) {
+        return threads_number;
+    }
+    size_t cores = std::thread::hardware_concurrency();
+    return cores == 0 ? 1 : cores;
+}
+
+/*=======================================================================================*/
 
-    return linked_list_insert_between(list, real_index, list->array[real_index].next, data);
+void list_sublists_free(list_sublists_t *sublists) {
+    free(sublists->heads);
+    free(sublists->lengths);
+    free(sublists->offsets);
+    free(sublists->successors);
+    free(sublists->splitter_of);
+    memset(sublists, 0, sizeof(list_sublists_t));
 }
 
 /*=======================================================================================*/
 
-list_error_t linked_list_insert_before(linked_list_t *list, size_t real_index, data_t data) {
-    LINKED_LIST_VERIFY(list);
-    C_ASSERT(real_index < list->capacity + 1, return LINKED_LIST_INVALID_INDEX);
+list_error_t list_free_bits_allocate(list_free_bits_t *bits, size_t bits_number) {
+    C_ASSERT(bits != NULL, return LINKED_LIST_NULL_PARAMETER);
 
-    return linked_list_insert_between(list, list->array[real_index].prev, real_index, data);
+    list_free_bits_free(bits);
+
+    size_t words_number = 0;
+    size_t level_words  = bits_number;
+    do {
+        level_words = (level_words + 63) / 64;
+        bits->offsets[bits->levels_number++] = words_number;
+        words_number += level_words;
+    } while(level_words > 1);
+    bits->offsets[bits->levels_number] = words_number;
+
+    bits->words = (uint64_t *)calloc(words_number, sizeof(uint64_t));
+    if(bits->words == NULL) {
+        list_free_bits_free(bits);
+        return LINKED_LIST_MEMORY_ERROR;
+    }
+    bits->bits_number = bits_number;
+    return LINKED_LIST_SUCCESS;
 }
 
 /*=======================================================================================*/
 
-list_error_t linked_list_remove(linked_list_t *list, size_t real_index, data_t *output) {
-    LINKED_LIST_VERIFY(list);
-    C_ASSERT(real_index  != 0                 , return LINKED_LIST_INVALID_INDEX );
-    C_ASSERT(real_index  <  list->capacity + 1, return LINKED_LIST_INVALID_INDEX );
-    C_ASSERT(output      != NULL              , return LINKED_LIST_NULL_PARAMETER);
+void list_free_bits_free(list_free_bits_t *bits) {
+    free(bits->words);
+    memset(bits, 0, sizeof(list_free_bits_t));
+}
 
-    *output                    = list->array[real_index].data;
+/*=======================================================================================*/
 
-    list_node_t *removing_node = list->array + real_index;
-    list_node_t *prev_node     = list->array + removing_node->prev;
-    list_node_t *next_node     = list->array + removing_node->next;
+size_t list_free_bits_nearest(const list_free_bits_t *bits, size_t position) {
+    C_ASSERT(bits != NULL, return 0);
 
-    prev_node->next            = removing_node->next;
-    next_node->prev            = removing_node->prev;
+    size_t after  = position < bits->bits_number ? list_free_bits_after(bits, 0, position) : SIZE_MAX;
+    size_t before = position != 0 ? list_free_bits_before(bits, 0, std::min(position, bits->bits_number) - 1) : SIZE_MAX;
+    if(after == SIZE_MAX && before == SIZE_MAX) {
+        return bits->bits_number;
+    }
+    if(before == SIZE_MAX || (after != SIZE_MAX && after - position <= position - before)) {
+        return after;
+    }
+    return before;
+}
 
-    removing_node->next        = list->free;
-    removing_node->prev        = poison_index;
-    removing_node->data        = poison_data;
+/*=======================================================================================*/
 
-    list->free                 = real_index;
-    list->size--;
+/* First set bit at or after position, SIZE_MAX if none. A word without */
+/* one sends the search to the level above for the next non-zero word.  */
+size_t list_free_bits_after(const list_free_bits_t *bits, size_t level, size_t position) {
+    const uint64_t *words = bits->words + bits->offsets[level];
+    size_t          word  = position >> 6;
+    if(word >= bits->offsets[level + 1] - bits->offsets[level]) {
+        return SIZE_MAX;
+    }
 
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
+    uint64_t masked = words[word] & (~0ull << (position & 63));
+    if(masked != 0) {
+        return word * 64 + (size_t)__builtin_ctzll(masked);
+    }
+    if(level + 1 == bits->levels_number) {
+        return SIZE_MAX;
+    }
+    size_t next_word = list_free_bits_after(bits, level + 1, word + 1);
+    if(next_word == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return next_word * 64 + (size_t)__builtin_ctzll(words[next_word]);
 }
 
 /*=======================================================================================*/
 
-list_error_t linked_list_dtor(linked_list_t *list) {
-    C_ASSERT(list != NULL, return LINKED_LIST_NULL);
+/* Last set bit at or before position, SIZE_MAX if none. */
+size_t list_free_bits_before(const list_free_bits_t *bits, size_t level, size_t position) {
+    const uint64_t *words = bits->words + bits->offsets[level];
+    size_t          word  = position >> 6;
+
+    uint64_t masked = words[word] & (~0ull >> (63 - (position & 63)));
+    if(masked != 0) {
+        return word * 64 + 63 - (size_t)__builtin_clzll(masked);
+    }
+    if(word == 0 || level + 1 == bits->levels_number) {
+        return SIZE_MAX;
+    }
+    size_t prev_word = list_free_bits_before(bits, level + 1, word - 1);
+    if(prev_word == SIZE_MAX) {
+        return SIZE_MAX;
+    }
+    return prev_word * 64 + 63 - (size_t)__builtin_clzll(words[prev_word]);
+}
+
+/*=======================================================================================*/
 
-    fclose(list->general_dump_file);
-    free(list->array);
+list_error_t list_tombstones_resize(list_tombstones_t *tombstones, size_t bits_number) {
+    C_ASSERT(tombstones != NULL, return LINKED_LIST_NULL_PARAMETER);
 
-    if(memset(list, 0, sizeof(linked_list_t)) != list) {
-        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
-                     "Error while setting list structure memory to zeros.\r\n");
+    size_t    words_number = (bits_number + 63) / 64;
+    uint64_t *words        = (uint64_t *)realloc(tombstones->words, words_number * sizeof(uint64_t));
+    if(words == NULL) {
         return LINKED_LIST_MEMORY_ERROR;
     }
-
+    if(words_number > tombstones->words_number) {
+        memset(words + tombstones->words_number, 0,
+               (words_number - tombstones->words_number) * sizeof(uint64_t));
+    }
+    tombstones->words        = words;
+    tombstones->words_number = words_number;
     return LINKED_LIST_SUCCESS;
 }
 
 /*=======================================================================================*/
 
+void list_tombstones_free(list_tombstones_t *tombstones) {
+    free(tombstones->words);
+    memset(tombstones, 0, sizeof(list_tombstones_t));
+}
+
+/*=======================================================================================*/
+
+void list_stats_write(const list_stats_t *stats, FILE *file, list_stats_format_t format) {
+    C_ASSERT(stats != NULL, return);
+    C_ASSERT(file  != NULL, return);
+
+    struct {
+        const char *name;
+        size_t      value;
+    } counters[] = {
+        {"inserts",           stats->inserts          },
+        {"removes",           stats->removes          },
+        {"compactions",       stats->compactions      },
+        {"free_pops",         stats->free_pops        },
+        {"reallocations",     stats->reallocations    },
+        {"reallocated_bytes", stats->reallocated_bytes},
+        {"verify_calls",      stats->verify_calls     },
+        {"verify_ns",         stats->verify_ns        },
+        {"dump_calls",        stats->dump_calls       },
+        {"dump_ns",           stats->dump_ns          },
+        {"peak_size",         stats->peak_size        },
+        {"size",              stats->size             },
+        {"capacity",          stats->capacity         },
+    };
+    size_t counters_number = sizeof(counters) / sizeof(counters[0]);
+
+    if(format == LINKED_LIST_STATS_JSON) {
+        fputc('{', file);
+        for(size_t counter = 0; counter < counters_number; counter++) {
+            fprintf(file, "\"%s\": %zu, ", counters[counter].name, counters[counter].value);
+        }
+        fprintf(file, "\"fragmentation\": %.4f}\n", stats->fragmentation);
+        return;
+    }
+    for(size_t counter = 0; counter < counters_number; counter++) {
+        fprintf(file, "%-18s %zu\n", counters[counter].name, counters[counter].value);
+    }
+    fprintf(file, "%-18s %.4f\n", "fragmentation", stats->fragmentation);
+}
+
+/*=======================================================================================*/
+
 #ifndef LINKED_LIST_OFF_DUMP
-    list_error_t linked_list_dump(linked_list_t *list,
-                                  const char    *caller_file,
-                                  size_t         caller_line,
-                                  const char    *caller_function,
-                                  const char    *list_variable_name,
-                                  const char    *header) {
-        C_ASSERT(list               != NULL, return LINKED_LIST_NULL_PARAMETER);
-        C_ASSERT(caller_file        != NULL, return LINKED_LIST_NULL_PARAMETER);
-        C_ASSERT(caller_line        != NULL, return LINKED_LIST_NULL_PARAMETER);
-        C_ASSERT(list_variable_name != NULL, return LINKED_LIST_NULL_PARAMETER);
-
-        char dot_filename[max_file_name_length] = {};
-        char img_filename[max_file_name_length] = {};
+    list_error_t linked_list_dump_filenames(size_t  dumps_number,
+                                            char   *dot_filename,
+                                            char   *img_filename) {
+        C_ASSERT(dot_filename != NULL, return LINKED_LIST_NULL_PARAMETER);
+        C_ASSERT(img_filename != NULL, return LINKED_LIST_NULL_PARAMETER);
 
         sprintf(dot_filename,
                 "%s/%s/dump%llu.dot",
                 log_folder,
                 dump_dot_file_folder,
-                list->dumps_number);
+                dumps_number);
         sprintf(img_filename,
                 "%s/dump%llu.svg",
                 dump_png_file_folder,
-                list->dumps_number);
-
-        list_error_t error_code = LINKED_LIST_SUCCESS;
-        if((error_code = linked_list_create_dot_dump(list, dot_filename)) != LINKED_LIST_SUCCESS) {
-            return error_code;
-        }
-
-        if((error_code = linked_list_create_png_dump(list,
-                                                     img_filename,
-                                                     dot_filename,
-                                                     caller_file,
-                                                     caller_line,
-                                                     caller_function,
-                                                     list_variable_name,
-                                                     header)) != LINKED_LIST_SUCCESS) {
-            return error_code;
-        }
-        list->dumps_number++;
+                dumps_number);
         return LINKED_LIST_SUCCESS;
     }
 
     /*=======================================================================================*/
 
-    list_error_t linked_list_create_png_dump(linked_list_t *list,
-                                             const char    *img_filename,
-                                             const char    *dot_filename,
-                                             const char    *caller_file,
-                                             size_t         caller_line,
-                                             const char    *caller_function,
-                                             const char    *list_variable_name,
-                                             const char    *header) {
+    list_error_t linked_list_create_png_dump(FILE       *general_dump_file,
+                                             const char *img_filename,
+                                             const char *dot_filename,
+                                             const char *caller_file,
+                                             size_t      caller_line,
+                                             const char *caller_function,
+                                             const char *list_variable_name,
+                                             const char *header,
+                                             const void *list,
+                                             size_t      capacity,
+                                             size_t      free,
+                                             const void *array,
+                                             const list_dump_stats_t *stats) {
         char dot_system_command[max_system_command_length] = {};
         sprintf(dot_system_command,
                 "dot %s -Tsvg -o %s/%s",
@@ -237,7 +395,35 @@ list_error_t linked_list_dtor(linked_list_t *list) {
                 img_filename);
         system(dot_system_command);
 
-        fprintf(list->general_dump_file,
+        return linked_list_write_dump_entry(general_dump_file,
+                                            img_filename,
+                                            caller_file,
+                                            caller_line,
+                                            caller_function,
+                                            list_variable_name,
+                                            header,
+                                            list,
+                                            capacity,
+                                            free,
+                                            array,
+                                            stats);
+    }
+
+    /*=======================================================================================*/
+
+    list_error_t linked_list_write_dump_entry(FILE       *general_dump_file,
+                                              const char *img_filename,
+                                              const char *caller_file,
+                                              size_t      caller_line,
+                                              const char *caller_function,
+                                              const char *list_variable_name,
+                                              const char *header,
+                                              const void *list,
+                                              size_t      capacity,
+                                              size_t      free,
+                                              const void *array,
+                                              const list_dump_stats_t *stats) {
+        fprintf(general_dump_file,
                 "<h1>==========================================================</h1>\r\n"
                 "<h1>Linked list dump '%s'</h1>\r\n"
                 "Called from '%s' in %s:%llu\r\n"
@@ -245,6 +431,8 @@ list_error_t linked_list_dtor(linked_list_t *list) {
                 "\tcapacity = %llu\r\n"
                 "\tfree     = %llu\r\n"
                 "\tdata [0x%p]\r\n"
+                "\tchain = %zu, free list = %zu, shown = %zu\r\n"
+                "\tmean jump = %.2f, longest run = %zu\r\n"
                 "<img src = \"%s\">\r\n",
                 header,
                 caller_function,
@@ -252,121 +440,91 @@ list_error_t linked_list_dtor(linked_list_t *list) {
                 caller_line,
                 list_variable_name,
                 list,
-                list->capacity,
-                list->free,
-                list->array,
+                capacity,
+                free,
+                array,
+                stats->chain_length,
+                stats->free_length,
+                stats->shown_nodes,
+                stats->mean_jump,
+                stats->longest_run,
                 img_filename);
-        fflush(list->general_dump_file);
+        fflush(general_dump_file);
         return LINKED_LIST_SUCCESS;
     }
 
     /*=======================================================================================*/
 
-    list_error_t linked_list_create_dot_dump(linked_list_t *list,
-                                             const char    *filename) {
-        FILE *dot_file = fopen(filename, "wb");
-        if(dot_file == NULL) {
+    list_error_t list_dump_writer_open(list_dump_writer_t *writer, const char *filename) {
+        C_ASSERT(writer   != NULL, return LINKED_LIST_NULL_PARAMETER);
+        C_ASSERT(filename != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+        writer->file = fopen(filename, "wb");
+        if(writer->file == NULL) {
             color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
                          "Error while opening dump file.\r\n");
             return LINKED_LIST_DUMP_ERROR;
         }
-
-        fputs("digraph {\r\n"
-              "node[shape = Mrecord, style = filled];\r\n"
-              "splines=ortho;\r\n"
-              "rankdir = LR;\r\n", dot_file);
-
-        linked_list_write_nodes(list, dot_file);
-
-        linked_list_write_node_connections(list, dot_file);
-
-        fprintf(dot_file, "FREE[fillcolor = \"#d8e2dc\"]");
-        if(list->free < list->capacity + 1) {
-            fprintf(dot_file, "FREE -> node%llx[color = \"#9d8189\", constraint = false];\r\n", list->free);
-        }
-
-        for(size_t free = list->free; free < list->capacity; free = list->array[free].next) {
-            fprintf(dot_file, "node%llx -> node%llx[color = \"#9d8189\", constraint = false];\r\n",
-            free, list->array[free].next);
-        }
-
-        fputs("}\n", dot_file);
-        fclose(dot_file);
+        writer->buffer = (char *)malloc(dump_writer_buffer_size);
+        writer->used   = 0;
         return LINKED_LIST_SUCCESS;
     }
 
     /*=======================================================================================*/
 
-    list_error_t linked_list_write_nodes(linked_list_t *list, FILE *dot_file) {
-        for(size_t node = 0; node < list->capacity + 1; node++) {
-            const char *color = linked_list_element_color(list, node);
-            char prev[16] = {};
-            if(list->array[node].prev == poison_index) {
-                sprintf(prev, "\\n(POISON)");
-            }
-            else {
-                sprintf(prev, "%llx", list->array[node].prev);
-            }
+    void list_dump_write(list_dump_writer_t *writer, const char *format, ...) {
+        va_list args;
+        va_start(args, format);
+        if(writer->buffer == NULL) {
+            vfprintf(writer->file, format, args);
+            va_end(args);
+            return;
+        }
 
-            fprintf(dot_file,
-                    "node%llx[label = \"%llu | {prev = %s} | {next = %llx} | {data = %d  }\", "
-                    "fillcolor = \"%s\", "
-                    "width = 1.5, height = 2];\n",
-                    node,
-                    node,
-                    prev,
-                    list->array[node].next,
-                    list->array[node].data,
-                    color);
+        if(dump_writer_buffer_size - writer->used < max_dump_line_length) {
+            fwrite(writer->buffer, 1, writer->used, writer->file);
+            writer->used = 0;
         }
-        return LINKED_LIST_SUCCESS;
+        int length = vsnprintf(writer->buffer + writer->used,
+                               dump_writer_buffer_size - writer->used,
+                               format,
+                               args);
+        va_end(args);
+
+        if(length < 0) {
+            return;
+        }
+        if((size_t)length >= dump_writer_buffer_size - writer->used) {
+            /* Longer than the space left, write it out directly. */
+            fwrite(writer->buffer, 1, writer->used, writer->file);
+            writer->used = 0;
+            va_start(args, format);
+            vfprintf(writer->file, format, args);
+            va_end(args);
+            return;
+        }
+        writer->used += (size_t)length;
     }
 
     /*=======================================================================================*/
 
-    list_error_t linked_list_write_node_connections(linked_list_t *list,
-                                                    FILE          *dot_file) {
-        for(size_t edge = 0; edge < list->capacity ; edge++) {
-            fprintf(dot_file, "node%llx -> node%llx[style = invis];\r\n",
-            edge, edge + 1);
-        }
-
-
-        for(size_t node = 0, counter = 0; node != 0 || counter == 0; counter++, node = list->array[node].next) {
-            if(list->array[list->array[node].next].prev == node) {
-                fprintf(dot_file, "node%llx -> node%llx[color = \"#06d6a0\", constraint = false];\r\n",
-                        node, list->array[node].next);
-            }
-            else {
-                fprintf(dot_file, "node%llx -> node%llx[color = \"#ff006e\", constraint = false];\r\n",
-                        node, list->array[node].next);
-                fprintf(dot_file, "node%llx -> node%llx[color = \"#ff006e\", constraint = false];\r\n",
-                        list->array[list->array[node].next].prev, list->array[node].next);
-            }
-        }
-
-        return LINKED_LIST_SUCCESS;
-    }
+    list_error_t list_dump_writer_close(list_dump_writer_t *writer) {
+        C_ASSERT(writer != NULL, return LINKED_LIST_NULL_PARAMETER);
 
-    const char *linked_list_element_color(linked_list_t *list, size_t node) {
-        if(node == 0) {
-            return zero_color;
-        }
-        else if(node == linked_list_get_head(list)) {
-            return head_color;
-        }
-        else if(node == linked_list_get_tail(list)) {
-            return tail_color;
+        if(writer->buffer != NULL) {
+            fwrite(writer->buffer, 1, writer->used, writer->file);
+            free(writer->buffer);
         }
-        else if(list->array[node].prev != poison_index) {
-            return elem_color;
-        }
-        return free_color;
+        bool failed = ferror(writer->file) != 0;
+        failed = fclose(writer->file) != 0 || failed;
+        memset(writer, 0, sizeof(list_dump_writer_t));
+        return failed ? LINKED_LIST_DUMP_ERROR : LINKED_LIST_SUCCESS;
     }
 
     /*=======================================================================================*/
 
-    list_error_t linked_list_initialize_dump(linked_list_t *list) {
+    list_error_t linked_list_initialize_dump(FILE **general_dump_file) {
+        C_ASSERT(general_dump_file != NULL, return LINKED_LIST_NULL_PARAMETER);
 
         char command[max_system_command_length] = {};
         sprintf(command, "md %s", log_folder);
@@ -378,16 +536,16 @@ list_error_t linked_list_dtor(linked_list_t *list) {
         sprintf(command, "md %s\\%s", log_folder, dump_png_file_folder);
         system(command);
 
-        list->general_dump_file = fopen(general_log_file_name, "wb");
-        if(list->general_dump_file == NULL) {
+        *general_dump_file = fopen(general_log_file_name, "wb");
+        if(*general_dump_file == NULL) {
             color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
                          "Error while opening log file.\r\n");
             return LINKED_LIST_DUMP_ERROR;
         }
 
-        fputs("<pre>\r\n", list->general_dump_file);
+        fputs("<pre>\r\n", *general_dump_file);
 
-        fprintf(list->general_dump_file,
+        fprintf(*general_dump_file,
                 "<pre>\r\n"
                 "<h3 style = \"background: %s;\">zero element color</h3>"
                 "<h3 style = \"background: %s;\">head element color</h3>"
@@ -398,149 +556,169 @@ list_error_t linked_list_dtor(linked_list_t *list) {
 
         return LINKED_LIST_SUCCESS;
     }
-#endif
 
-/*=======================================================================================*/
+    /*=======================================================================================*/
 
-list_error_t linked_list_find_free(linked_list_t *list, size_t *output) {
-    LINKED_LIST_VERIFY(list);
-    C_ASSERT(output      != NULL, return LINKED_LIST_NULL_PARAMETER);
+    list_error_t linked_list_dump_start_worker(void) {
+        std::lock_guard<std::mutex> lock(dump_mutex);
+        if(dump_worker_started) {
+            return LINKED_LIST_SUCCESS;
+        }
 
-    list_error_t error_code = LINKED_LIST_SUCCESS;
+        static bool exit_handler_set = false;
+        if(!exit_handler_set) {
+            /* A joinable thread left to static destructors would terminate. */
+            atexit(linked_list_dump_at_exit);
+            exit_handler_set = true;
+        }
 
-    if(list->size == list->capacity) {
-        if((error_code = list_reallocate_memory(list)) != LINKED_LIST_SUCCESS) {
-            return error_code;
+        dump_worker_stopping = false;
+        try {
+            dump_worker = std::thread(linked_list_dump_worker);
+        }
+        catch(...) {
+            color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                         "Error while starting dump worker.\r\n");
+            return LINKED_LIST_DUMP_ERROR;
         }
+        dump_worker_started = true;
+        return LINKED_LIST_SUCCESS;
     }
 
-    *output = list->free;
-    list->free = list->array[list->free].next;
-
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
-}
-
-/*=======================================================================================*/
+    /*=======================================================================================*/
 
-list_error_t linked_list_insert_between(linked_list_t *list,
-                                        size_t         prev_node,
-                                        size_t         next_node,
-                                        data_t         data) {
-    LINKED_LIST_VERIFY(list);
+    list_error_t linked_list_dump_stop_worker(void) {
+        {
+            std::lock_guard<std::mutex> lock(dump_mutex);
+            if(!dump_worker_started) {
+                return LINKED_LIST_SUCCESS;
+            }
+            dump_worker_stopping = true;
+        }
+        dump_queue_filled.notify_one();
+        dump_worker.join();
 
-    size_t insertion_index = 0;
-    list_error_t error_code = LINKED_LIST_SUCCESS;
-    if((error_code = linked_list_find_free(list, &insertion_index)) != LINKED_LIST_SUCCESS) {
-        return error_code;
+        std::lock_guard<std::mutex> lock(dump_mutex);
+        dump_worker_started = false;
+        return LINKED_LIST_SUCCESS;
     }
 
-    list_node_t *insertion_node = list->array + insertion_index;
-
-    insertion_node->data        = data;
-    insertion_node->prev        = prev_node;
-    insertion_node->next        = next_node;
-
-    list->array[prev_node].next = insertion_index;
-    list->array[next_node].prev = insertion_index;
-
-    list->size++;
-
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
-}
-
-/*=======================================================================================*/
-
-list_error_t list_reallocate_memory(linked_list_t *list) {
-    LINKED_LIST_VERIFY(list);
-    list_error_t error_code = LINKED_LIST_SUCCESS;
+    /*=======================================================================================*/
 
-    list->array = (list_node_t *)realloc(list->array, (list->capacity * 2 + 1) * sizeof(list_node_t));
-    if(list->array == NULL) {
-        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
-                     "Error while reallocating list memory.\r\n");
-        return LINKED_LIST_MEMORY_ERROR;
+    void linked_list_dump_wait(void) {
+        std::unique_lock<std::mutex> lock(dump_mutex);
+        while(dump_queue_head != NULL || dump_worker_busy) {
+            dump_queue_drained.wait(lock);
+        }
     }
 
-    if(memset(list->array + list->capacity + 1, 0,
-              list->capacity * sizeof(list_node_t)) !=
-       list->array + list->capacity + 1) {
-        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
-                     "Error while setting allocated memory to zeros.\r\n");
-        return LINKED_LIST_MEMORY_ERROR;
-    }
+    /*=======================================================================================*/
 
-    if((error_code = linked_list_set_default(list,
-                                             list->capacity + 1,
-                                             list->capacity * 2 + 1)) != LINKED_LIST_SUCCESS) {
-        return error_code;
+    bool linked_list_dump_worker_running(void) {
+        std::lock_guard<std::mutex> lock(dump_mutex);
+        return dump_worker_started && !dump_worker_stopping;
     }
 
-    list->capacity *= 2;
-
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
-}
+    /*=======================================================================================*/
 
-/*=======================================================================================*/
+    list_error_t linked_list_dump_enqueue(list_dump_job_t *job) {
+        C_ASSERT(job != NULL, return LINKED_LIST_NULL_PARAMETER);
 
-size_t linked_list_get_head(linked_list_t *list) {
-    return list->array->next;
-}
+        {
+            std::lock_guard<std::mutex> lock(dump_mutex);
+            if(dump_queue_tail == NULL) {
+                dump_queue_head = job;
+            }
+            else {
+                dump_queue_tail->next = job;
+            }
+            dump_queue_tail = job;
+        }
+        dump_queue_filled.notify_one();
+        return LINKED_LIST_SUCCESS;
+    }
 
-/*=======================================================================================*/
+    /*=======================================================================================*/
 
-size_t linked_list_get_tail(linked_list_t *list) {
-    return list->array->prev;
-}
+    /* Takes the whole queue at once, so dumps made while a batch renders */
+    /* are rendered together in the next one. Exits once stopped and empty. */
+    void linked_list_dump_worker(void) {
+        std::unique_lock<std::mutex> lock(dump_mutex);
+        while(true) {
+            while(dump_queue_head == NULL && !dump_worker_stopping) {
+                dump_queue_filled.wait(lock);
+            }
+            if(dump_queue_head == NULL) {
+                return;
+            }
 
-/*=======================================================================================*/
+            list_dump_job_t *batch = dump_queue_head;
+            dump_queue_head  = NULL;
+            dump_queue_tail  = NULL;
+            dump_worker_busy = true;
 
-list_error_t linked_list_set_default(linked_list_t *list,
-                                     size_t         start,
-                                     size_t         end) {
-    LINKED_LIST_VERIFY(list);
+            lock.unlock();
+            linked_list_dump_batch(batch);
+            lock.lock();
 
-    for(size_t node = start; node < end; node++) {
-        list->array[node].data = poison_data;
-        list->array[node].next = node + 1;
-        list->array[node].prev = poison_index;
+            dump_worker_busy = false;
+            if(dump_queue_head == NULL) {
+                dump_queue_drained.notify_all();
+            }
+        }
     }
 
-    LINKED_LIST_VERIFY(list);
-    return LINKED_LIST_SUCCESS;
-}
-
-/*=======================================================================================*/
+    /*=======================================================================================*/
 
-#ifndef LINKED_LIST_OFF_VERIFICATION
-    list_error_t linked_list_verify(linked_list_t *list) {
-        if(list == NULL) {
-            return LINKED_LIST_NULL;
-        }
-        if(list->array == NULL) {
-            return LINKED_LIST_NULL_DATA;
+    void linked_list_dump_batch(list_dump_job_t *batch) {
+        for(list_dump_job_t *job = batch; job != NULL; job = job->next) {
+            if(job->render != NULL) {
+                job->render(job->snapshot, job->dot_filename, &job->stats);
+                free(job->snapshot);
+            }
         }
-        if(list->size > list->capacity) {
-            return LINKED_LIST_INVALID_SIZE;
+
+        /* Every dump gets its own -o to land where a synchronous one does, */
+        /* the calls are chained so one shell still renders the batch.      */
+        char command[max_batch_command_length] = {};
+        for(list_dump_job_t *first = batch; first != NULL;) {
+            size_t           length = 0;
+            list_dump_job_t *job    = first;
+            do {
+                length += (size_t)sprintf(command + length,
+                                          "%sdot %s -Tsvg -o %s/%s",
+                                          job == first ? "" : " & ",
+                                          job->dot_filename,
+                                          log_folder,
+                                          job->img_filename);
+                job = job->next;
+            } while(job != NULL && length + max_system_command_length < max_batch_command_length);
+            system(command);
+            first = job;
         }
 
-        for(size_t node = 0, counter = 0; list->array[node].next != 0; node++, counter++) {
-            if(list->array[node].next > list->capacity) {
-                return LINKED_LIST_INVALID_NODE_NEXT;
-            }
-            if(list->array[node].prev > list->capacity) {
-                return LINKED_LIST_INVALID_NODE_PREV;
-            }
-            if(list->array[list->array[node].prev].next != node ||
-               list->array[list->array[node].next].prev != node) {
-                return LINKED_LIST_INVALID_NODE_CONNECTION;
-            }
-            if(counter > list->size) {
-                return LINKED_LIST_LOOP_ERROR;
-            }
+        while(batch != NULL) {
+            list_dump_job_t *next = batch->next;
+            linked_list_write_dump_entry(batch->general_dump_file,
+                                         batch->img_filename,
+                                         batch->caller_file,
+                                         batch->caller_line,
+                                         batch->caller_function,
+                                         batch->list_variable_name,
+                                         batch->header,
+                                         batch->list,
+                                         batch->capacity,
+                                         batch->free,
+                                         batch->array,
+                                         &batch->stats);
+            free(batch);
+            batch = next;
         }
-        return LINKED_LIST_SUCCESS;
+    }
+
+    /*=======================================================================================*/
+
+    void linked_list_dump_at_exit(void) {
+        linked_list_dump_stop_worker();
     }
 #endif
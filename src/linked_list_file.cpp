@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "custom_assert.h"
+#include "colors.h"
+#include "linked_list.h"
+
+#ifdef LINKED_LIST_MAPPED_FILES
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*=======================================================================================*/
+
+LINKED_LIST_INSTANTIATE_FILE(, linked_list_t)
+LINKED_LIST_INSTANTIATE_FILE(, soa_linked_list_t)
+
+/*=======================================================================================*/
+
+static list_error_t list_file_remap     (list_file_t *file,
+                                         size_t       new_size);
+static void        *list_file_allocate  (void        *context,
+                                         size_t       size);
+static void        *list_file_reallocate(void        *context,
+                                         void        *block,
+                                         size_t       old_size,
+                                         size_t       new_size);
+static void         list_file_free      (void        *context,
+                                         void        *block,
+                                         size_t       size);
+static uint64_t     list_checksum_update(uint64_t     checksum,
+                                         const void  *data,
+                                         size_t       size);
+
+/*=======================================================================================*/
+
+list_error_t list_file_map(list_file_t *file, const char *path, bool *created) {
+    C_ASSERT(file    != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(path    != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(created != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    memset(file, 0, sizeof(list_file_t));
+    file->fd                   = -1;
+    file->allocator.allocate   = list_file_allocate;
+    file->allocator.reallocate = list_file_reallocate;
+    file->allocator.free       = list_file_free;
+    file->allocator.context    = file;
+
+    file->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(file->fd < 0) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while opening list file '%s'.\r\n", path);
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    struct stat file_stat = {};
+    if(fstat(file->fd, &file_stat) != 0) {
+        list_file_unmap(file);
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    size_t file_size = (size_t)file_stat.st_size;
+    *created = file_size < list_file_header_size;
+    if(*created) {
+        file_size = list_file_header_size;
+    }
+
+    if(list_file_remap(file, file_size) != LINKED_LIST_SUCCESS) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while mapping list file '%s'.\r\n", path);
+        list_file_unmap(file);
+        return LINKED_LIST_FILE_ERROR;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+list_error_t list_file_flush(list_file_t *file) {
+    C_ASSERT(file != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    if(msync(file->mapping, file->mapped_size, MS_SYNC) != 0) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while flushing list file.\r\n");
+        return LINKED_LIST_FILE_ERROR;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+void list_file_unmap(list_file_t *file) {
+    if(file->mapping != NULL) {
+        munmap(file->mapping, file->mapped_size);
+    }
+    if(file->fd >= 0) {
+        close(file->fd);
+    }
+    file->fd          = -1;
+    file->mapping     = NULL;
+    file->mapped_size = 0;
+    file->block_taken = false;
+}
+
+/*=======================================================================================*/
+
+list_error_t list_snapshot_write(int fd, const void *data, size_t size, uint64_t *checksum) {
+    C_ASSERT(data     != NULL || size == 0, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(checksum != NULL             , return LINKED_LIST_NULL_PARAMETER);
+
+    const char *bytes = (const char *)data;
+    for(size_t done = 0; done < size; ) {
+        size_t chunk = size - done < list_snapshot_chunk_size ? size - done : list_snapshot_chunk_size;
+        *checksum = list_checksum_update(*checksum, bytes + done, chunk);
+
+        for(size_t written = 0; written < chunk; ) {
+            ssize_t result = write(fd, bytes + done + written, chunk - written);
+            if(result <= 0) {
+                color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                             "Error while writing snapshot.\r\n");
+                return LINKED_LIST_FILE_ERROR;
+            }
+            written += (size_t)result;
+        }
+        done += chunk;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+list_error_t list_snapshot_read(int fd, void *data, size_t size, uint64_t *checksum) {
+    C_ASSERT(data     != NULL || size == 0, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(checksum != NULL             , return LINKED_LIST_NULL_PARAMETER);
+
+    char *bytes = (char *)data;
+    for(size_t done = 0; done < size; ) {
+        size_t chunk = size - done < list_snapshot_chunk_size ? size - done : list_snapshot_chunk_size;
+
+        for(size_t read_bytes = 0; read_bytes < chunk; ) {
+            ssize_t result = read(fd, bytes + done + read_bytes, chunk - read_bytes);
+            if(result <= 0) {
+                color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                             "Snapshot is truncated or unreadable.\r\n");
+                return LINKED_LIST_FILE_ERROR;
+            }
+            read_bytes += (size_t)result;
+        }
+
+        *checksum = list_checksum_update(*checksum, bytes + done, chunk);
+        done += chunk;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* Word at a time multiply and fold. Chunks are multiples of 8 bytes except */
+/* the last piece of a transfer, so the result does not depend on chunking  */
+/* as long as only the final transfer has an odd length.                    */
+uint64_t list_checksum_update(uint64_t checksum, const void *data, size_t size) {
+    const char *bytes = (const char *)data;
+
+    size_t offset = 0;
+    for(; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + offset, sizeof(word));
+        checksum  = (checksum ^ word) * 0x9e3779b97f4a7c15ULL;
+        checksum ^= checksum >> 29;
+    }
+    if(offset < size) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + offset, size - offset);
+        checksum  = (checksum ^ word ^ (uint64_t)(size - offset) << 56) * 0x9e3779b97f4a7c15ULL;
+        checksum ^= checksum >> 29;
+    }
+    return checksum;
+}
+
+/*=======================================================================================*/
+
+/* Resizes the file and its mapping together. The file grows before the */
+/* mapping and shrinks after it, so no mapped page is ever past its end. */
+list_error_t list_file_remap(list_file_t *file, size_t new_size) {
+    if(new_size > file->mapped_size && ftruncate(file->fd, (off_t)new_size) != 0) {
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    void *mapping = NULL;
+    if(file->mapping == NULL) {
+        mapping = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    }
+    else {
+        #ifdef __linux__
+            mapping = mremap(file->mapping, file->mapped_size, new_size, MREMAP_MAYMOVE);
+        #else
+            munmap(file->mapping, file->mapped_size);
+            mapping = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+        #endif
+    }
+    if(mapping == MAP_FAILED) {
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    /* A file that fails to shrink only keeps some unused bytes. */
+    if(new_size < file->mapped_size) {
+        (void)ftruncate(file->fd, (off_t)new_size);
+    }
+
+    file->mapping     = (char *)mapping;
+    file->mapped_size = new_size;
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+/* The first block asked for is the node storage and goes to the file, */
+/* anything else (the order index) is an ordinary heap block.          */
+void *list_file_allocate(void *context, size_t size) {
+    list_file_t *file = (list_file_t *)context;
+
+    if(file->block_taken) {
+        return calloc(1, size);
+    }
+    if(list_file_remap(file, list_file_header_size + size) != LINKED_LIST_SUCCESS) {
+        return NULL;
+    }
+
+    file->block_taken = true;
+    return file->mapping + list_file_header_size;
+}
+
+/*=======================================================================================*/
+
+void *list_file_reallocate(void *context, void *block, size_t, size_t new_size) {
+    list_file_t *file = (list_file_t *)context;
+
+    if(!file->block_taken || block != file->mapping + list_file_header_size) {
+        return realloc(block, new_size);
+    }
+    if(list_file_remap(file, list_file_header_size + new_size) != LINKED_LIST_SUCCESS) {
+        return NULL;
+    }
+    return file->mapping + list_file_header_size;
+}
+
+/*=======================================================================================*/
+
+/* Freeing the node storage only unmaps it, the file keeps the nodes. */
+void list_file_free(void *context, void *block, size_t) {
+    list_file_t *file = (list_file_t *)context;
+
+    if(!file->block_taken || block != file->mapping + list_file_header_size) {
+        free(block);
+        return;
+    }
+
+    munmap(file->mapping, file->mapped_size);
+    file->mapping     = NULL;
+    file->mapped_size = 0;
+    file->block_taken = false;
+}
+
+#endif
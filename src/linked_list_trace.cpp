@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+#include <mutex>
+
+#include "custom_assert.h"
+#include "colors.h"
+#include "linked_list.h"
+
+/*=======================================================================================*/
+
+/* Records are gathered here and written in blocks, one record is at most */
+/* an op byte and four 10 byte varints.                                   */
+static const size_t trace_buffer_size = 1 << 16;
+static const size_t max_record_size   = 1 + 4 * 10;
+
+std::atomic<bool> list_trace_running(false);
+
+static std::mutex  trace_mutex;
+static FILE       *trace_file                       = NULL;
+static uint8_t     trace_buffer[trace_buffer_size]  = {};
+static size_t      trace_buffer_used                = 0;
+static size_t      trace_next_id                    = 1;
+static size_t      trace_first_id                   = 1;
+static bool        trace_exit_registered            = false;
+
+static void         list_trace_flush  (void);
+static void         list_trace_at_exit(void);
+static uint8_t     *list_trace_put    (uint8_t        *output,
+                                       uint64_t        value);
+static list_error_t list_trace_get    (const uint8_t **cursor,
+                                       const uint8_t  *end,
+                                       uint64_t       *value);
+
+/*=======================================================================================*/
+
+list_error_t linked_list_trace_start(const char *path) {
+    C_ASSERT(path != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if(trace_file != NULL) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "A list trace is already being written.\r\n");
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    trace_file = fopen(path, "wb");
+    if(trace_file == NULL) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while opening trace file '%s'.\r\n", path);
+        return LINKED_LIST_FILE_ERROR;
+    }
+    memcpy(trace_buffer, list_trace_magic, list_trace_magic_size);
+    trace_buffer_used = list_trace_magic_size;
+    trace_first_id    = trace_next_id;
+
+    if(!trace_exit_registered) {
+        atexit(list_trace_at_exit);
+        trace_exit_registered = true;
+    }
+    list_trace_running.store(true);
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+list_error_t linked_list_trace_stop(void) {
+    list_trace_running.store(false);
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if(trace_file == NULL) {
+        return LINKED_LIST_SUCCESS;
+    }
+    list_trace_flush();
+    bool failed = ferror(trace_file) != 0;
+    failed      = fclose(trace_file) != 0 || failed;
+    trace_file  = NULL;
+    if(failed) {
+        color_printf(RED_TEXT, BOLD_TEXT, DEFAULT_BACKGROUND,
+                     "Error while writing list trace.\r\n");
+        return LINKED_LIST_FILE_ERROR;
+    }
+    return LINKED_LIST_SUCCESS;
+}
+
+/*=======================================================================================*/
+
+size_t list_trace_new_id(void) {
+    if(!list_trace_running.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    return trace_file == NULL ? 0 : trace_next_id++;
+}
+
+/*=======================================================================================*/
+
+/* Ids keep growing across traces, so a list built during an earlier trace */
+/* is told apart from the ones of this trace. The file numbers them from 1. */
+void list_trace_write(const list_trace_record_t *record) {
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if(trace_file == NULL || record->list < trace_first_id) {
+        return;
+    }
+    if(trace_buffer_used + max_record_size > trace_buffer_size) {
+        list_trace_flush();
+    }
+
+    bool has_index = false;
+    bool has_slot  = false;
+    bool has_value = false;
+    if(!list_trace_fields(record->op, &has_index, &has_slot, &has_value)) {
+        return;
+    }
+
+    uint8_t *output = trace_buffer + trace_buffer_used;
+    *output++ = (uint8_t)record->op;
+    output    = list_trace_put(output, record->list - trace_first_id + 1);
+    if(has_index) {
+        output = list_trace_put(output, record->index);
+    }
+    if(has_slot) {
+        output = list_trace_put(output, record->slot);
+    }
+    if(has_value) {
+        output = list_trace_put(output, (uint64_t)record->value << 1 ^ (uint64_t)(record->value >> 63));
+    }
+    trace_buffer_used = (size_t)(output - trace_buffer);
+}
+
+/*=======================================================================================*/
+
+list_error_t list_trace_read(const uint8_t **cursor, const uint8_t *end, list_trace_record_t *record) {
+    C_ASSERT(cursor  != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(*cursor != NULL, return LINKED_LIST_NULL_PARAMETER);
+    C_ASSERT(record  != NULL, return LINKED_LIST_NULL_PARAMETER);
+
+    if(*cursor >= end) {
+        return LINKED_LIST_FILE_ERROR;
+    }
+    memset(record, 0, sizeof(list_trace_record_t));
+    record->op = (list_trace_op_t)*(*cursor)++;
+
+    bool has_index = false;
+    bool has_slot  = false;
+    bool has_value = false;
+    if(!list_trace_fields(record->op, &has_index, &has_slot, &has_value)) {
+        return LINKED_LIST_FILE_ERROR;
+    }
+
+    uint64_t     list       = 0;
+    uint64_t     index      = 0;
+    uint64_t     slot       = 0;
+    uint64_t     value      = 0;
+    list_error_t error_code = list_trace_get(cursor, end, &list);
+    if(error_code == LINKED_LIST_SUCCESS && has_index) {
+        error_code = list_trace_get(cursor, end, &index);
+    }
+    if(error_code == LINKED_LIST_SUCCESS && has_slot) {
+        error_code = list_trace_get(cursor, end, &slot);
+    }
+    if(error_code == LINKED_LIST_SUCCESS && has_value) {
+        error_code = list_trace_get(cursor, end, &value);
+    }
+
+    record->list  = (size_t)list;
+    record->index = (size_t)index;
+    record->slot  = (size_t)slot;
+    record->value = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    return error_code;
+}
+
+/*=======================================================================================*/
+
+bool list_trace_fields(list_trace_op_t op, bool *has_index, bool *has_slot, bool *has_value) {
+    C_ASSERT(has_index != NULL, return false);
+    C_ASSERT(has_slot  != NULL, return false);
+    C_ASSERT(has_value != NULL, return false);
+
+    *has_index = false;
+    *has_slot  = false;
+    *has_value = false;
+    switch(op) {
+        case LIST_TRACE_CTOR:
+        case LIST_TRACE_REMOVE:
+        case LIST_TRACE_SORT: {
+            *has_index = true;
+            return true;
+        }
+        case LIST_TRACE_INSERT_AFTER:
+        case LIST_TRACE_INSERT_BEFORE: {
+            *has_index = true;
+            *has_slot  = true;
+            *has_value = true;
+            return true;
+        }
+        case LIST_TRACE_INSERT_RANGE_AFTER:
+        case LIST_TRACE_INSERT_RANGE_BEFORE: {
+            *has_index = true;
+            *has_value = true;
+            return true;
+        }
+        case LIST_TRACE_RANGE_NODE: {
+            *has_slot  = true;
+            *has_value = true;
+            return true;
+        }
+        case LIST_TRACE_REMOVE_RANGE: {
+            *has_index = true;
+            *has_slot  = true;
+            return true;
+        }
+        case LIST_TRACE_DTOR:
+        case LIST_TRACE_CLEAR:
+        case LIST_TRACE_LINEARIZE:
+        case LIST_TRACE_SHRINK:
+        case LIST_TRACE_RELINK: {
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+/*=======================================================================================*/
+
+/* Called with trace_mutex held. */
+void list_trace_flush(void) {
+    fwrite(trace_buffer, 1, trace_buffer_used, trace_file);
+    trace_buffer_used = 0;
+}
+
+/*=======================================================================================*/
+
+void list_trace_at_exit(void) {
+    linked_list_trace_stop();
+}
+
+/*=======================================================================================*/
+
+/* Seven bits per byte, low bits first, the high bit marks a next byte. */
+uint8_t *list_trace_put(uint8_t *output, uint64_t value) {
+    while(value >= 0x80) {
+        *output++ = (uint8_t)(value | 0x80);
+        value   >>= 7;
+    }
+    *output++ = (uint8_t)value;
+    return output;
+}
+
+/*=======================================================================================*/
+
+list_error_t list_trace_get(const uint8_t **cursor, const uint8_t *end, uint64_t *value) {
+    *value = 0;
+    for(size_t shift = 0; shift < 64; shift += 7) {
+        if(*cursor >= end) {
+            return LINKED_LIST_FILE_ERROR;
+        }
+        uint8_t byte = *(*cursor)++;
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        if((byte & 0x80) == 0) {
+            return LINKED_LIST_SUCCESS;
+        }
+    }
+    return LINKED_LIST_FILE_ERROR;
+}